@@ -0,0 +1,598 @@
+// Benchmarks. Those aren't a part of the tests, and only print the timings.
+// Run with `make benchmarks`.
+
+
+#define BETTERLISTINIT_PARALLEL 1
+#define BETTERLISTINIT_ARENA 1
+#define BETTERLISTINIT_PADDED 1
+#define BETTERLISTINIT_BOXED 1
+#define BETTERLISTINIT_NUMERIC 1
+#if (defined(_MSVC_LANG) ? _MSVC_LANG : __cplusplus) >= 202002
+#define BETTERLISTINIT_COROUTINES 1
+#endif
+#include "better_list_init.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <memory>
+#include <regex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+// Expands to the preferred init list notation for the current language standard.
+#if BETTERLISTINIT_ALLOW_BRACES
+#define INIT(...) BETTERLISTINIT_INIT{__VA_ARGS__}
+#else
+#define INIT(...) BETTERLISTINIT_INIT(__VA_ARGS__)
+#endif
+
+
+// Stops the optimizer from discarding `value`.
+template <typename T>
+void use(T &value)
+{
+    #if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r"(&value) : "memory");
+    #else
+    static void *volatile sink;
+    sink = &value;
+    #endif
+}
+
+// Runs `func` a number of times, and prints the average time per iteration.
+// Returns the time in nanoseconds.
+template <typename F>
+double benchmark(const char *name, F &&func, long iterations = 200000)
+{
+    using clock = std::chrono::steady_clock;
+
+    // Warm up.
+    for (long i = 0; i < iterations / 10; i++)
+        func();
+
+    clock::time_point start = clock::now();
+    for (long i = 0; i < iterations; i++)
+        func();
+    double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count() / double(iterations);
+
+    std::printf("  %-60s %10.1f ns\n", name, ns);
+    return ns;
+}
+
+
+// A range that doesn't store anything, to measure just our own overhead when constructing ranges.
+struct Sum
+{
+    using value_type = long;
+    long value = 0;
+
+    template <typename Iter>
+    Sum(Iter begin, Iter end)
+    {
+        for (; begin != end; ++begin)
+            value += value_type(*begin);
+    }
+};
+
+void benchmark_conversion()
+{
+    std::printf("Converting lists of 8 elements to a range (mostly the overhead of our own layers, compare optimized and `-O0` builds):\n");
+
+    int a = 1;
+    long b = 2;
+    short c = 3;
+    char d = 4;
+
+    benchmark("homogeneous init{...}", [&]
+    {
+        Sum sum(INIT(a, a, a, a, a, a, a, a));
+        use(sum);
+    }, 2000000);
+
+    benchmark("heterogeneous init{...}", [&]
+    {
+        Sum sum(INIT(a, b, c, d, a, b, c, d));
+        use(sum);
+    }, 2000000);
+
+    benchmark("heterogeneous init{...} with when()", [&]
+    {
+        Sum sum(INIT(a, b, c, d, better_list_init::when(a > 0, a), b, c, d));
+        use(sum);
+    }, 2000000);
+}
+
+// A moderately expensive element expression.
+std::string make_entry(int i)
+{
+    return "entry " + std::to_string(i) + ": " + std::string(48, char('a' + i));
+}
+
+void benchmark_prototype()
+{
+    std::printf("Stamping out the same container repeatedly:\n");
+
+    benchmark("init{...}, re-evaluating the elements each time", []
+    {
+        std::vector<std::string> vec = INIT(make_entry(1), make_entry(2), make_entry(3), make_entry(4), make_entry(5), make_entry(6), make_entry(7), make_entry(8));
+        use(vec);
+    });
+
+    #if BETTERLISTINIT_ALLOW_BRACES
+    const better_list_init::prototype proto{make_entry(1), make_entry(2), make_entry(3), make_entry(4), make_entry(5), make_entry(6), make_entry(7), make_entry(8)};
+    #else
+    const auto proto = better_list_init::prototype(make_entry(1), make_entry(2), make_entry(3), make_entry(4), make_entry(5), make_entry(6), make_entry(7), make_entry(8));
+    #endif
+    benchmark("prototype{...}, copying the stored elements", [&]
+    {
+        std::vector<std::string> vec = proto;
+        use(vec);
+    });
+}
+
+void benchmark_spread()
+{
+    std::printf("Concatenating a few elements and a range:\n");
+
+    std::vector<std::string> source;
+    for (int i = 0; i < 16; i++)
+        source.push_back(make_entry(i));
+
+    benchmark("push_back() and insert()", [&]
+    {
+        std::vector<std::string> vec;
+        vec.push_back(source[0]);
+        vec.push_back(source[1]);
+        vec.insert(vec.end(), source.begin(), source.end());
+        vec.push_back(source[2]);
+        use(vec);
+    });
+
+    benchmark("init{a, b, spread(range), c}", [&]
+    {
+        std::vector<std::string> vec = INIT(source[0], source[1], better_list_init::spread(source), source[2]);
+        use(vec);
+    });
+}
+
+void benchmark_transform()
+{
+    std::printf("Building a container of transformed elements:\n");
+
+    std::string a = make_entry(1), b = make_entry(2), c = make_entry(3), d = make_entry(4);
+    auto wrap = [](const std::string &str){return std::vector<std::string>{str};};
+
+    benchmark("intermediate container + push_back()", [&]
+    {
+        std::vector<std::string> source = INIT(a, b, c, d);
+        std::vector<std::vector<std::string>> vec;
+        vec.reserve(source.size());
+        for (const std::string &elem : source)
+            vec.push_back(wrap(elem));
+        use(vec);
+    });
+
+    benchmark("init{wrap(a), ...}", [&]
+    {
+        std::vector<std::vector<std::string>> vec = INIT(wrap(a), wrap(b), wrap(c), wrap(d));
+        use(vec);
+    });
+
+    benchmark("init{a, ...}.transform(wrap)", [&]
+    {
+        std::vector<std::vector<std::string>> vec = INIT(a, b, c, d).transform(wrap);
+        use(vec);
+    });
+}
+
+void benchmark_parallel()
+{
+    std::printf("Constructing expensive elements (`std::regex`) on several threads (%u hardware threads):\n", std::thread::hardware_concurrency());
+
+    std::vector<std::string> patterns;
+    for (int i = 0; i < 32; i++)
+    {
+        std::string pattern = "(";
+        pattern += std::to_string(i);
+        pattern += "[a-z]+|[0-9]{2,";
+        pattern += std::to_string(i % 5 + 2);
+        pattern += "})+(foo|bar|baz)*";
+        patterns.push_back(pattern);
+    }
+
+    benchmark("init{spread(patterns)}", [&]
+    {
+        std::vector<std::regex> vec = INIT(better_list_init::spread(patterns));
+        use(vec);
+    }, 200);
+
+    for (unsigned threads : {1u, 2u, 4u, 8u})
+    {
+        std::string name = "init{spread(patterns)}.parallel(" + std::to_string(threads) + ")";
+        benchmark(name.c_str(), [&]
+        {
+            std::vector<std::regex> vec = INIT(better_list_init::spread(patterns)).parallel(threads);
+            use(vec);
+        }, 200);
+    }
+
+    benchmark("init{spread(patterns)}.parallel(), in place in fixed_buffer", [&]
+    {
+        better_list_init::fixed_buffer<std::regex> buf = INIT(better_list_init::spread(patterns)).parallel();
+        use(buf);
+    }, 200);
+}
+
+void benchmark_arena()
+{
+    constexpr int num_sets = 64, set_size = 2000;
+
+    std::printf("Looking up all keys in %d sets of %d elements, built on a fragmented heap:\n", num_sets, set_size);
+
+    std::vector<int> keys;
+    for (int i = 0; i < set_size; i++)
+        keys.push_back(i * 7919 % set_size);
+
+    // Fragment the heap: allocate many node-sized blocks, then free every other one, so the set nodes get scattered.
+    std::vector<std::unique_ptr<char[]>> junk;
+    for (int i = 0; i < num_sets * set_size * 2; i++)
+        junk.emplace_back(new char[40]);
+    for (std::size_t i = 0; i < junk.size(); i += 2)
+        junk[i].reset();
+
+    // Together the sets don't fit in the cache.
+    std::vector<std::set<int>> regular;
+    std::vector<better_list_init::arena<std::pmr::set<int>>> in_arena;
+    for (int i = 0; i < num_sets; i++)
+    {
+        regular.push_back(INIT(better_list_init::spread(keys)));
+        in_arena.push_back(INIT(better_list_init::spread(keys)).in_arena());
+    }
+
+    auto lookup_all = [&](const auto &sets, const auto &get)
+    {
+        std::size_t sum = 0;
+        for (int i = 0; i < set_size; i++)
+        {
+            for (const auto &set : sets)
+                sum += std::size_t(*get(set).find(i));
+        }
+        use(sum);
+    };
+
+    benchmark("std::set<int> = init{...}", [&]{lookup_all(regular, [](const auto &set) -> auto & {return set;});}, 20);
+    benchmark("arena<std::pmr::set<int>> = init{...}.in_arena()", [&]{lookup_all(in_arena, [](const auto &set) -> auto & {return *set;});}, 20);
+}
+
+void benchmark_false_sharing()
+{
+    unsigned threads = std::thread::hardware_concurrency();
+    if (threads < 2)
+        threads = 2;
+    if (threads > 8)
+        threads = 8;
+    constexpr int increments = 1000000;
+
+    std::printf("Incrementing per-thread counters, %d times on each of %u threads (needs several cores to show the difference):\n", increments, threads);
+
+    // Each thread increments its own counter.
+    auto run = [&](auto &counters)
+    {
+        std::vector<std::thread> list;
+        for (unsigned i = 0; i < threads; i++)
+        {
+            list.emplace_back([&counters, i]
+            {
+                for (int j = 0; j < increments; j++)
+                    counters[i].fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+        for (std::thread &thread : list)
+            thread.join();
+        use(counters);
+    };
+
+    benchmark("std::vector<std::atomic_int> = init{repeat(n, 0)}", [&]
+    {
+        std::vector<std::atomic_int> counters = INIT(better_list_init::repeat(threads, 0));
+        run(counters);
+    }, 20);
+
+    benchmark("padded_buffer<std::atomic_int> = init{repeat(n, 0)}", [&]
+    {
+        better_list_init::padded_buffer<std::atomic_int> counters = INIT(better_list_init::repeat(threads, 0));
+        run(counters);
+    }, 20);
+}
+
+// Polymorphic types for `.boxed<Base>()`.
+struct Base
+{
+    virtual ~Base() = default;
+    virtual long value() const = 0;
+};
+struct Small : Base
+{
+    int x;
+    Small(int x) : x(x) {}
+    long value() const override {return x;}
+};
+struct Large : Base
+{
+    long x[6];
+    Large(long y) : x{y, y, y, y, y, y} {}
+    long value() const override {return x[0] + x[5];}
+};
+
+void benchmark_boxed()
+{
+    std::printf("Constructing 8 polymorphic objects, then calling a virtual function on each:\n");
+
+    benchmark("std::vector<std::unique_ptr<Base>> = init{std::make_unique<...>(...), ...}", []
+    {
+        std::vector<std::unique_ptr<Base>> vec = INIT(
+            std::make_unique<Small>(1), std::make_unique<Large>(2), std::make_unique<Small>(3), std::make_unique<Large>(4),
+            std::make_unique<Small>(5), std::make_unique<Large>(6), std::make_unique<Small>(7), std::make_unique<Large>(8)
+        );
+        long sum = 0;
+        for (const auto &elem : vec)
+            sum += elem->value();
+        use(sum);
+    });
+
+    benchmark("poly_buffer<Base> = init{...}.boxed<Base>()", []
+    {
+        better_list_init::poly_buffer<Base> buf = INIT(Small(1), Large(2), Small(3), Large(4), Small(5), Large(6), Small(7), Large(8)).boxed<Base>();
+        long sum = 0;
+        for (Base *elem : buf)
+            sum += elem->value();
+        use(sum);
+    });
+}
+
+#if BETTERLISTINIT_HAVE_SIMD
+void benchmark_simd()
+{
+    namespace stdx = std::experimental;
+    using simd_t = stdx::fixed_size_simd<float, 8>;
+
+    std::printf("Loading 8 floats into a SIMD vector, then adding it to an accumulator:\n");
+
+    float a = 1, b = 2, c = 3, d = 4, e = 5, f = 6, g = 7, h = 8;
+    simd_t sum = 0;
+
+    benchmark("simd v; v[0] = a; v[1] = b; ...", [&]
+    {
+        use(a);
+        simd_t vec;
+        vec[0] = a; vec[1] = b; vec[2] = c; vec[3] = d;
+        vec[4] = e; vec[5] = f; vec[6] = g; vec[7] = h;
+        sum += vec;
+        use(sum);
+    }, 10000000);
+
+    benchmark("simd v = init{a, b, ...}", [&]
+    {
+        use(a);
+        simd_t vec = INIT(a, b, c, d, e, f, g, h);
+        sum += vec;
+        use(sum);
+    }, 10000000);
+}
+#endif
+
+#if BETTERLISTINIT_COROUTINES
+// A minimal lazy coroutine.
+template <typename T>
+struct Task
+{
+    struct promise_type
+    {
+        T value{};
+        std::coroutine_handle<> continuation;
+
+        // For `sync_wait()`.
+        std::mutex *mutex = nullptr;
+        std::condition_variable *cv = nullptr;
+        bool *done = nullptr;
+
+        Task get_return_object() {return Task{std::coroutine_handle<promise_type>::from_promise(*this)};}
+        std::suspend_always initial_suspend() noexcept {return {};}
+        void return_value(T new_value) {value = std::move(new_value);}
+        void unhandled_exception() {std::terminate();}
+
+        struct final_awaiter
+        {
+            bool await_ready() noexcept {return false;}
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+            {
+                promise_type &promise = handle.promise();
+                if (promise.continuation)
+                    return promise.continuation;
+                std::lock_guard<std::mutex> lock(*promise.mutex);
+                *promise.done = true;
+                promise.cv->notify_one();
+                return std::noop_coroutine();
+            }
+            void await_resume() noexcept {}
+        };
+        final_awaiter final_suspend() noexcept {return {};}
+    };
+
+    std::coroutine_handle<promise_type> handle;
+
+    Task(Task &&other) noexcept : handle(std::exchange(other.handle, {})) {}
+    ~Task()
+    {
+        if (handle)
+            handle.destroy();
+    }
+
+    bool await_ready() const noexcept {return false;}
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept
+    {
+        handle.promise().continuation = continuation;
+        return handle;
+    }
+    T await_resume() {return std::move(handle.promise().value);}
+
+  private:
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+};
+
+// Runs a task to completion, on the current thread and whatever threads it switches to.
+template <typename T>
+T sync_wait(Task<T> task)
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = false;
+    task.handle.promise().mutex = &mutex;
+    task.handle.promise().cv = &cv;
+    task.handle.promise().done = &done;
+    task.handle.resume();
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&]{return done;});
+    return task.await_resume();
+}
+
+// A fixed-size pool of threads, executing the jobs in FIFO order. An executor for `init{...}.when_all()`.
+class thread_pool
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::coroutine_handle<>> queue;
+    bool stopping = false;
+    std::vector<std::thread> threads;
+
+    void work()
+    {
+        while (true)
+        {
+            std::coroutine_handle<> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [&]{return stopping || !queue.empty();});
+                if (queue.empty())
+                    return;
+                job = queue.front();
+                queue.pop_front();
+            }
+            job.resume();
+        }
+    }
+
+  public:
+    explicit thread_pool(unsigned num_threads)
+    {
+        for (unsigned i = 0; i < num_threads; i++)
+            threads.emplace_back([this]{work();});
+    }
+
+    thread_pool(const thread_pool &) = delete;
+    thread_pool &operator=(const thread_pool &) = delete;
+
+    // Finishes the queued jobs, then joins the threads.
+    ~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cv.notify_all();
+        for (std::thread &thread : threads)
+            thread.join();
+    }
+
+    std::size_t size() const {return threads.size();}
+
+    // The executor interface for `init{...}.when_all()`.
+    void post(std::coroutine_handle<> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(job);
+        }
+        cv.notify_one();
+    }
+};
+
+// Some CPU-bound work.
+Task<long> compute(long n)
+{
+    long x = 0;
+    for (long i = 0; i < n; i++)
+    {
+        x = x * 31 + i;
+        use(x);
+    }
+    co_return x;
+}
+
+void benchmark_when_all()
+{
+    constexpr long n = 100000;
+    thread_pool pool(4);
+
+    std::printf("Awaiting 4 CPU-bound tasks, and collecting the results into a `std::vector<long>` (needs several cores to show the difference):\n");
+
+    benchmark("co_await a; co_await b; ...", [&]
+    {
+        std::vector<long> results = sync_wait([]() -> Task<std::vector<long>>
+        {
+            std::vector<long> ret;
+            ret.reserve(4);
+            ret.push_back(co_await compute(n));
+            ret.push_back(co_await compute(n));
+            ret.push_back(co_await compute(n));
+            ret.push_back(co_await compute(n));
+            co_return ret;
+        }());
+        use(results);
+    }, 200);
+
+    benchmark("co_await init{a, b, ...}", [&]
+    {
+        std::vector<long> results = sync_wait([]() -> Task<std::vector<long>>
+        {
+            co_return co_await INIT(compute(n), compute(n), compute(n), compute(n));
+        }());
+        use(results);
+    }, 200);
+
+    benchmark("co_await init{a, b, ...}.when_all(thread_pool)", [&]
+    {
+        std::vector<long> results = sync_wait([&]() -> Task<std::vector<long>>
+        {
+            co_return co_await INIT(compute(n), compute(n), compute(n), compute(n)).when_all(pool);
+        }());
+        use(results);
+    }, 200);
+}
+#endif
+
+
+int main()
+{
+    benchmark_conversion();
+    benchmark_prototype();
+    benchmark_spread();
+    benchmark_transform();
+    benchmark_parallel();
+    benchmark_arena();
+    benchmark_false_sharing();
+    benchmark_boxed();
+    #if BETTERLISTINIT_HAVE_SIMD
+    benchmark_simd();
+    #endif
+    #if BETTERLISTINIT_COROUTINES
+    benchmark_when_all();
+    #endif
+}
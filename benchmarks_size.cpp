@@ -0,0 +1,49 @@
+// A binary size benchmark. It isn't a part of the tests, run it with `make size_benchmarks`.
+// Each object file built from this source converts lists of `LIST_SIZE` elements to a `std::vector`, for several element types.
+// The lists are homogeneous, or if `HETEROGENEOUS` is true, they alternate between the element type and `long`.
+
+
+#include "better_list_init.hpp"
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+
+#ifndef LIST_SIZE
+#define LIST_SIZE 10
+#endif
+
+#ifndef HETEROGENEOUS
+#define HETEROGENEOUS 0
+#endif
+
+// Expands to the preferred init list notation for the current language standard.
+#if BETTERLISTINIT_ALLOW_BRACES
+#define INIT(...) BETTERLISTINIT_INIT{__VA_ARGS__}
+#else
+#define INIT(...) BETTERLISTINIT_INIT(__VA_ARGS__)
+#endif
+
+template <typename T, std::size_t ...I>
+std::vector<long> make_list(T x, long y, std::index_sequence<I...>)
+{
+    #if HETEROGENEOUS
+    return INIT(std::get<I % 2>(std::tie(x, y))...);
+    #else
+    (void)y;
+    return INIT(((void)I, x)...);
+    #endif
+}
+
+#define INSTANTIATE(type_) template std::vector<long> make_list(type_, long, std::make_index_sequence<LIST_SIZE>);
+INSTANTIATE(char)
+INSTANTIATE(signed char)
+INSTANTIATE(unsigned char)
+INSTANTIATE(short)
+INSTANTIATE(int)
+INSTANTIATE(unsigned)
+INSTANTIATE(long long)
+INSTANTIATE(double)
+#undef INSTANTIATE
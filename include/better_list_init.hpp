@@ -32,7 +32,7 @@
 
 // The version number: `major*10000 + minor*100 + patch`.
 #ifndef BETTERLISTINIT_VERSION
-#define BETTERLISTINIT_VERSION 10000
+#define BETTERLISTINIT_VERSION 10100
 #endif
 
 // This file is included by this header automatically, if it exists.
@@ -69,6 +69,9 @@ namespace better_list_init
         template <typename T>
         T &&declval() noexcept; // Not defined.
 
+        // Selects our own placement-new, see below.
+        struct placement_new_tag {};
+
         template <typename T>
         void accept_parameter(T) noexcept; // Not defined.
 
@@ -161,6 +164,34 @@ namespace better_list_init
         struct default_is_range<T, decltype(void(declval<typename custom::element_type<T>::type>()))> : std::integral_constant<bool, !is_aggregate<T>::value> {};
     }
 
+    namespace detail
+    {
+        // The default value for `custom::is_element_copy`, see below.
+        template <typename T, typename U>
+        struct default_is_element_copy : std::integral_constant<bool,
+            std::is_class<T>::value && !std::is_trivially_copyable<T>::value &&
+            std::is_base_of<T, std::remove_cv_t<std::remove_reference_t<U>>>::value &&
+            (std::is_lvalue_reference<U>::value || std::is_const<std::remove_reference_t<U>>::value)
+        > {};
+
+        // The default value for `custom::normalized_elem`, see below.
+        template <typename T, typename U, typename = void>
+        struct default_normalized_elem {using type = U;};
+        // Scalars are converted to a scalar `T` up front. This isn't observable, since converting scalars has no side effects.
+        template <typename T, typename U>
+        struct default_normalized_elem<T, U, std::enable_if_t<std::is_scalar<T>::value && std::is_scalar<std::remove_reference_t<U>>::value && std::is_convertible<U, T>::value>>
+        {
+            using type = T;
+        };
+        // Lvalues of `T`, const or not, are bound to `const T &`, since `T` is copied from them either way.
+        // Only if `T` is trivially copyable, otherwise it could have a separate `T(T &)` constructor, which we must keep calling for non-const lvalues.
+        template <typename T, typename U>
+        struct default_normalized_elem<T, U, std::enable_if_t<!std::is_scalar<T>::value && std::is_trivially_copyable<T>::value && std::is_lvalue_reference<U>::value && std::is_same<std::remove_cv_t<std::remove_reference_t<U>>, T>::value>>
+        {
+            using type = const T &;
+        };
+    }
+
     // More customization points.
     namespace custom
     {
@@ -170,6 +201,23 @@ namespace better_list_init
         // By default, we're looking for `custom::element_type` (which defaults to `::value_type`), but reject aggregates.
         template <typename T, typename = void>
         struct is_range : detail::default_is_range<T> {};
+
+        // Whether constructing a range element `T` from a list element `U` (a reference, or a non-reference for prvalues) counts as a copy.
+        // `init{...}.strict()` rejects those.
+        // By default, this is true if `U` is an lvalue or a const rvalue of `T` (or of a class derived from it), unless `T` is trivially copyable
+        // (then copying is the same as moving). Specialize this to reject copying conversions too, e.g. `std::string` from `std::string_view`.
+        template <typename T, typename U, typename = void>
+        struct is_element_copy : detail::default_is_element_copy<T, U> {};
+
+        // Element type normalization, which lets "almost homogeneous" lists use the same iterators as homogeneous ones.
+        // `::type` is what a list element `U` (a forwarding reference) is converted to before constructing a range element `T` from it.
+        // If it's the same type for all elements of a heterogeneous list, the list is converted as if it was homogeneous. E.g. `init{1, 2u, 3L}` to `std::vector<long>`.
+        // If `::type` is a reference, it must bind to `U` directly. Otherwise the elements are first converted to a temporary array of `::type`, which must
+        // be default-constructible and move-assignable, and then the range elements are constructed from the rvalues.
+        // By default, scalars normalize to a scalar `T`, and lvalues of a trivially copyable `T` normalize to `const T &`. Otherwise `::type` is `U` itself.
+        // Specialize this to normalize more types, e.g. lvalues of your non-trivially-copyable types, if copying them from a non-const lvalue is the same as from a const one.
+        template <typename T, typename U, typename = void>
+        struct normalized_elem : detail::default_normalized_elem<T, U> {};
     }
 }
 
@@ -258,6 +306,12 @@ namespace better_list_init
 #define BETTERLISTINIT_FORWARD_DECLARE_ITERATOR_TAG 1
 #endif
 
+// Same, but for `std::tuple_size` and `std::tuple_element`, which we specialize to support structured bindings.
+// If this is disabled, we just include `<utility>`.
+#ifndef BETTERLISTINIT_FORWARD_DECLARE_TUPLE_TRAITS
+#define BETTERLISTINIT_FORWARD_DECLARE_TUPLE_TRAITS 1
+#endif
+
 // How to stop the program when something bad happens.
 // This statement will be wrapped in 'diagostic push/pop' automatically.
 #ifndef BETTERLISTINIT_ABORT
@@ -279,6 +333,26 @@ namespace better_list_init
 #endif
 #endif
 
+// Applied to the trivial forwarding functions (iterator operators, element references, conversion helpers),
+// to force-inline them even in unoptimized builds, and to hide them from the debugger's "step into".
+// Without this, debug builds spend a lot of time in the call chain of our conversion operators.
+#ifndef BETTERLISTINIT_FORCEINLINE
+#if defined(__GNUC__) || defined(__clang__)
+#if defined(__has_attribute)
+#if __has_attribute(__artificial__)
+#define BETTERLISTINIT_FORCEINLINE __attribute__((__always_inline__, __artificial__))
+#endif
+#endif
+#ifndef BETTERLISTINIT_FORCEINLINE
+#define BETTERLISTINIT_FORCEINLINE __attribute__((__always_inline__))
+#endif
+#elif defined(_MSC_VER)
+#define BETTERLISTINIT_FORCEINLINE __forceinline
+#else
+#define BETTERLISTINIT_FORCEINLINE
+#endif
+#endif
+
 // Whether `std::is_aggregate` is available.
 #ifndef BETTERLISTINIT_HAVE_IS_AGGREGATE
 #if BETTERLISTINIT_CXX_STANDARD >= 17
@@ -322,6 +396,101 @@ namespace better_list_init
 #define BETTERLISTINIT_ALLOCATOR_HACK_IGNORE_EXISTING_CONSTRUCT_FUNC 0
 #endif
 
+// Whether to enable `init{...}.parallel()`, which constructs the elements on several threads, and the `fixed_buffer<T>` container.
+// This is opt-in, because it includes `<thread>` and `<atomic>`, and on some platforms needs linking the thread support library (e.g. `-pthread`).
+// This requires exceptions to be enabled, since the exceptions thrown by the elements are transferred from the worker threads to the caller.
+#ifndef BETTERLISTINIT_PARALLEL
+#define BETTERLISTINIT_PARALLEL 0
+#endif
+
+// Whether to enable `init{...}.in_arena()`, which places a container and its nodes in a single preallocated `std::pmr::monotonic_buffer_resource` buffer.
+// This is opt-in, because it includes `<memory_resource>`. Requires C++17.
+#ifndef BETTERLISTINIT_ARENA
+#define BETTERLISTINIT_ARENA 0
+#endif
+#if BETTERLISTINIT_ARENA && BETTERLISTINIT_CXX_STANDARD < 17
+#error "`BETTERLISTINIT_ARENA` requires C++17 or newer."
+#endif
+
+// Whether to construct `std::variant` range elements directly from the matching alternatives, using `std::in_place_index`.
+// Without this, they go through the `std::variant` converting constructor, which is more expensive to compile.
+// This is opt-in, because it includes `<variant>`. Requires C++17.
+#ifndef BETTERLISTINIT_VARIANT
+#define BETTERLISTINIT_VARIANT 0
+#endif
+#if BETTERLISTINIT_VARIANT && BETTERLISTINIT_CXX_STANDARD < 17
+#error "`BETTERLISTINIT_VARIANT` requires C++17 or newer."
+#endif
+
+// Whether to enable the `padded_buffer<T>` container, which places each element in its own cache line.
+// This is opt-in, because it includes `<iterator>` and `<new>`.
+#ifndef BETTERLISTINIT_PADDED
+#define BETTERLISTINIT_PADDED 0
+#endif
+
+// Whether to enable `init{...}.boxed<Base>()`, which constructs objects derived from `Base` in a single allocation, and the `poly_buffer<Base>` container.
+// This is opt-in, because it includes `<new>`.
+#ifndef BETTERLISTINIT_BOXED
+#define BETTERLISTINIT_BOXED 0
+#endif
+
+// Whether `init{...}` can be converted to `std::shared_ptr<T[]>`, with the control block and the elements in a single allocation.
+// This is opt-in, because it includes `<memory>` and `<new>`. Requires C++17.
+#ifndef BETTERLISTINIT_SHARED_ARRAY
+#define BETTERLISTINIT_SHARED_ARRAY 0
+#endif
+#if BETTERLISTINIT_SHARED_ARRAY && BETTERLISTINIT_CXX_STANDARD < 17
+#error "`BETTERLISTINIT_SHARED_ARRAY` requires C++17 or newer."
+#endif
+
+// Whether `init{...}` can be converted to the numeric types: `std::valarray<T>`, and `std::experimental::simd<T, Abi>` (if available, in C++17 and newer).
+// This is opt-in, because it includes `<valarray>` and `<experimental/simd>`.
+#ifndef BETTERLISTINIT_NUMERIC
+#define BETTERLISTINIT_NUMERIC 0
+#endif
+
+// Whether `init{...}` lists of awaitables can be awaited, which awaits all of them concurrently (`co_await init{a, b}`, or `init{a, b}.when_all(executor)`),
+// and the `inline_executor`. Bring your own executor (anything with `.post(std::coroutine_handle<>)`) to run the elements on other threads.
+// This is opt-in, because it includes `<coroutine>` and `<atomic>`. Requires C++20.
+// This requires exceptions to be enabled: if an element throws, the exception is caught and rethrown from the `co_await` once all elements finish.
+#ifndef BETTERLISTINIT_COROUTINES
+#define BETTERLISTINIT_COROUTINES 0
+#endif
+#if BETTERLISTINIT_COROUTINES && BETTERLISTINIT_CXX_STANDARD < 20
+#error "`BETTERLISTINIT_COROUTINES` requires C++20 or newer."
+#endif
+
+// The default alignment for the elements of `padded_buffer<T>`.
+// We don't use `std::hardware_destructive_interference_size`, because it's not always available, and GCC warns about using it in headers,
+// since it depends on the compiler flags. 64 bytes is correct for x86 and most ARM CPUs. Apple ARM CPUs use 128-byte lines.
+#ifndef BETTERLISTINIT_CACHE_LINE_SIZE
+#define BETTERLISTINIT_CACHE_LINE_SIZE 64
+#endif
+
+// Performance lint: diagnoses `init{...}` lists that are likely more expensive than they need to be, when they're converted.
+// 0 = disabled, 1 = deprecation warnings, 2 = hard errors. See `detail::lint_...` for the list of checks.
+#ifndef BETTERLISTINIT_LINT
+#define BETTERLISTINIT_LINT 0
+#endif
+
+// With `BETTERLISTINIT_LINT`, lists with more elements than this are diagnosed, since each element adds to the instantiation cost.
+#ifndef BETTERLISTINIT_LINT_MAX_SIZE
+#define BETTERLISTINIT_LINT_MAX_SIZE 64
+#endif
+
+// Whether to call the tracing hooks (`custom::trace_construct` and `custom::trace_element`) when converting lists, to collect statistics at runtime.
+// This is opt-in, and compiled out by default.
+#ifndef BETTERLISTINIT_TRACE
+#define BETTERLISTINIT_TRACE 0
+#endif
+// In C++20 the hooks are skipped during constant evaluation. Before that, enabling them makes the conversions non-`constexpr`.
+// The `inline` is needed for `BETTERLISTINIT_FORCEINLINE`.
+#if BETTERLISTINIT_CXX_STANDARD >= 20
+#define BETTERLISTINIT_CONSTEXPR_TRACE constexpr
+#else
+#define BETTERLISTINIT_CONSTEXPR_TRACE inline
+#endif
+
 
 #if !BETTERLISTINIT_FORWARD_DECLARE_ITERATOR_TAG
 #include <iterator>
@@ -346,16 +515,118 @@ _STD_END
 #endif
 #endif
 
+#if !BETTERLISTINIT_FORWARD_DECLARE_TUPLE_TRAITS
+#include <utility>
+#else
+#if defined(__GLIBCXX__)
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+    _GLIBCXX_BEGIN_NAMESPACE_VERSION
+    template <typename T> struct tuple_size;
+    template <decltype(sizeof(int)) I, typename T> struct tuple_element;
+    _GLIBCXX_END_NAMESPACE_VERSION
+}
+#elif defined(_LIBCPP_VERSION)
+_LIBCPP_BEGIN_NAMESPACE_STD
+template <typename T> struct _LIBCPP_TEMPLATE_VIS tuple_size;
+template <decltype(sizeof(int)) I, typename T> struct _LIBCPP_TEMPLATE_VIS tuple_element;
+_LIBCPP_END_NAMESPACE_STD
+#elif defined(_MSC_VER)
+_STD_BEGIN
+template <typename T> struct tuple_size;
+template <decltype(sizeof(int)) I, typename T> struct tuple_element;
+_STD_END
+#else
+#include <utility>
+#endif
+#endif
+
 #if BETTERLISTINIT_ALLOCATOR_HACK
 #include <memory> // For `std::allocator_traits`.
 #endif
 
+#if BETTERLISTINIT_PARALLEL
+#include <atomic>
+#include <exception>
+#include <iterator> // For `std::move_iterator`.
+#include <memory>
+#include <thread>
+#endif
+
+#if BETTERLISTINIT_VARIANT
+#include <variant>
+#endif
+
+#if BETTERLISTINIT_PADDED
+#include <iterator>
+#include <new>
+#endif
+
+#if BETTERLISTINIT_BOXED
+#include <new>
+#endif
+
+#if BETTERLISTINIT_SHARED_ARRAY
+#include <memory>
+#include <new>
+#endif
+
+#if BETTERLISTINIT_COROUTINES
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <new> // For `std::launder()`.
+#endif
+
+#if BETTERLISTINIT_NUMERIC
+#include <valarray>
+#if BETTERLISTINIT_CXX_STANDARD >= 17 && defined(__has_include)
+#if __has_include(<experimental/simd>)
+#include <experimental/simd>
+#endif
+#endif
+// Whether `std::experimental::simd` is available.
+#ifndef BETTERLISTINIT_HAVE_SIMD
+#ifdef __cpp_lib_experimental_parallel_simd
+#define BETTERLISTINIT_HAVE_SIMD 1
+#else
+#define BETTERLISTINIT_HAVE_SIMD 0
+#endif
+#endif
+#endif
+
+#if BETTERLISTINIT_ARENA
+#include <cstddef> // For `std::max_align_t`.
+#include <memory>
+#include <memory_resource>
+#endif
+
 #if !BETTERLISTINIT_HAVE_IS_AGGREGATE
 #include <array> // Need this to specialize `detail::default_is_range`, see below for details.
 #endif
 
+// Placement-new, so that `init{...}.construct_at()` doesn't need `<new>`. Use it as `::new(better_list_init::detail::placement_new_tag{}, ptr) T(...)`.
+// The tag parameter makes sure this doesn't conflict with anything.
+inline void *operator new(decltype(sizeof(int)), better_list_init::detail::placement_new_tag, void *ptr) {return ptr;}
+// Called if the constructor throws.
+inline void operator delete(void *, better_list_init::detail::placement_new_tag, void *) noexcept {}
+
 namespace better_list_init
 {
+    namespace type
+    {
+        template <typename ...P>
+        class BETTERLISTINIT_IDENTIFIER;
+        template <typename T>
+        class when;
+        template <typename R>
+        class spread;
+        template <typename F>
+        class generate;
+        template <typename T>
+        class repeat;
+    }
+
     namespace detail
     {
         #if BETTERLISTINIT_HAVE_IS_AGGREGATE
@@ -398,13 +669,19 @@ namespace better_list_init
         template <typename T> struct any_of<T> : T {};
         template <typename T, typename ...P> struct any_of<T, P...> : std::conditional_t<T::value, T, any_of<P...>> {};
 
+        // Non-short-circuiting versions of the above, for long packs.
+        // Those don't recurse, so the instantiation depth doesn't grow with the pack size.
+        template <bool ...X> struct bool_list {};
+        template <typename ...P> struct all_of_flat : std::is_same<bool_list<true, bool(P::value)...>, bool_list<bool(P::value)..., true>> {};
+        template <typename ...P> struct any_of_flat : std::integral_constant<bool, !std::is_same<bool_list<false, bool(P::value)...>, bool_list<bool(P::value)..., false>>::value> {};
+
         template <typename T> struct negate : std::integral_constant<bool, !T::value> {};
 
         // Returns true if all types in `P...` are the same.
         template <typename ...P>
         struct all_types_same : std::true_type {};
         template <typename T, typename ...P>
-        struct all_types_same<T, P...> : all_of<std::is_same<T, P>...> {};
+        struct all_types_same<T, P...> : all_of_flat<std::is_same<T, P>...> {};
 
         // Returns the first type in a list.
         template <typename ...P>
@@ -412,6 +689,109 @@ namespace better_list_init
         template <typename T, typename ...P>
         struct first_type<T, P...> {using type = T;};
 
+        // Don't want to include `<utility>` for `std::index_sequence`, so we roll our own.
+        template <size_t ...I>
+        struct index_sequence {};
+
+        // `make_index_sequence<N>` returns `index_sequence<0, 1, ..., N-1>`.
+        // This has a logarithmic instantiation depth, to not choke on long lists.
+        template <typename A, typename B>
+        struct concat_index_sequences {};
+        template <size_t ...I, size_t ...J>
+        struct concat_index_sequences<index_sequence<I...>, index_sequence<J...>> {using type = index_sequence<I..., (sizeof...(I) + J)...>;};
+        template <size_t N>
+        struct make_index_sequence_helper : concat_index_sequences<typename make_index_sequence_helper<N / 2>::type, typename make_index_sequence_helper<N - N / 2>::type> {};
+        template <>
+        struct make_index_sequence_helper<0> {using type = index_sequence<>;};
+        template <>
+        struct make_index_sequence_helper<1> {using type = index_sequence<0>;};
+        template <size_t N>
+        using make_index_sequence = typename make_index_sequence_helper<N>::type;
+
+        // Returns the `I`th type in a list.
+        // This is implemented with overload resolution rather than recursion, to not choke on long lists.
+        template <size_t I, typename T>
+        struct indexed_type {using type = T;};
+        template <typename Seq, typename ...P>
+        struct indexed_types {};
+        template <size_t ...I, typename ...P>
+        struct indexed_types<index_sequence<I...>, P...> : indexed_type<I, P>... {};
+        template <size_t I, typename T>
+        indexed_type<I, T> pick_indexed_type(const indexed_type<I, T> *); // Not defined.
+        template <size_t I, typename ...P>
+        using nth_type = typename decltype(pick_indexed_type<I>((const indexed_types<make_index_sequence<sizeof...(P)>, P...> *)nullptr))::type;
+
+        // `Template<T, T, ..., T>`, with `T` repeated `N` times.
+        template <template <typename...> class Template, typename T, typename Seq>
+        struct repeat_type_helper {};
+        template <template <typename...> class Template, typename T, size_t ...I>
+        struct repeat_type_helper<Template, T, index_sequence<I...>> {using type = Template<typename first_type<T, std::integral_constant<size_t, I>>::type...>;};
+        template <template <typename...> class Template, typename T, size_t N>
+        using repeat_type = typename repeat_type_helper<Template, T, make_index_sequence<N>>::type;
+
+        // Returns `std::common_reference_t<P...>` if it exists (and we're in C++20), otherwise `void`.
+        template <typename Void, typename ...P>
+        struct common_reference_or_void_helper {using type = void;};
+        #if BETTERLISTINIT_CXX_STANDARD >= 20
+        template <typename ...P>
+        struct common_reference_or_void_helper<typename first_type<void, std::common_reference_t<P...>>::type, P...> {using type = std::common_reference_t<P...>;};
+        #endif
+        // `std::common_reference` recurses over the list, so if all types are the same, we only pass two of them.
+        template <bool AllSame, typename ...P>
+        struct common_reference_or_void_selector : common_reference_or_void_helper<void, P...> {};
+        template <typename T, typename ...P>
+        struct common_reference_or_void_selector<true, T, P...> : common_reference_or_void_helper<void, T, T> {};
+        template <typename ...P>
+        using common_reference_or_void = typename common_reference_or_void_selector<all_types_same<P...>::value && sizeof...(P) != 0, P...>::type;
+
+        // Used as a default template argument in place of `common_reference_or_void<P...>`, which is then computed by `resolve_common_reference`.
+        // Otherwise the default would be computed when the enclosing class is instantiated, which is expensive for long lists.
+        struct use_common_reference {};
+        template <typename R, typename ...P>
+        struct resolve_common_reference {using type = R;};
+        template <typename ...P>
+        struct resolve_common_reference<use_common_reference, P...> {using type = common_reference_or_void<P...>;};
+
+        // A list of types.
+        template <typename ...P>
+        struct type_list {};
+
+        // Whether each type in `A` is constructible from the respective type in `B`. Both must be `type_list`s.
+        template <typename Void, typename A, typename B>
+        struct pairwise_constructible_helper : std::false_type {};
+        template <typename ...P, typename ...Q>
+        struct pairwise_constructible_helper<std::enable_if_t<sizeof...(P) == sizeof...(Q)>, type_list<P...>, type_list<Q...>> : all_of_flat<std::is_constructible<P, Q>...> {};
+        template <typename A, typename B>
+        struct pairwise_constructible : pairwise_constructible_helper<void, A, B> {};
+
+        // A tag for the constructors that initialize stored values from the arguments.
+        struct from_values_tag {};
+
+        // A tuple that stores its elements by value. Unlike our main tuple (see below), this one can own things.
+        template <size_t I, typename T>
+        struct value_tuple_leaf
+        {
+            T value;
+
+            template <typename Q>
+            constexpr value_tuple_leaf(from_values_tag, Q &&param) : value(static_cast<Q &&>(param)) {}
+        };
+        template <typename Seq, typename ...P>
+        struct value_tuple_impl {};
+        template <size_t ...I, typename ...P>
+        struct value_tuple_impl<index_sequence<I...>, P...> : value_tuple_leaf<I, P>...
+        {
+            template <typename ...Q>
+            constexpr value_tuple_impl(from_values_tag, Q &&... params) : value_tuple_leaf<I, P>(from_values_tag{}, static_cast<Q &&>(params))... {}
+
+            template <size_t J>
+            constexpr nth_type<J, P...> &get() {return static_cast<value_tuple_leaf<J, nth_type<J, P...>> &>(*this).value;}
+            template <size_t J>
+            constexpr const nth_type<J, P...> &get() const {return static_cast<const value_tuple_leaf<J, nth_type<J, P...>> &>(*this).value;}
+        };
+        template <typename ...P>
+        using value_tuple = value_tuple_impl<make_index_sequence<sizeof...(P)>, P...>;
+
         // An empty struct, copyable only if the condition is true.
         template <bool IsCopyable>
         struct maybe_copyable {};
@@ -433,129 +813,104 @@ namespace better_list_init
 
         // We use a custom tuple class to avoid including `<tuple>` and because we need some extra functionality.
 
-        #if !BETTERLISTINIT_TUPLE_IMPL_V2
-        // A helper class for our tuple implementation.
-        template <typename ...P>
-        struct tuple_impl_regular_low
+        // Our tuple stores the element pointers in those, and heterogeneous lists point their `elem_ref`s to them, to type-erase the elements.
+        // We can't erase them to `void *`, because casting from it isn't constexpr until C++26, but a downcast is.
+        struct elem_holder_base {};
+        // Points to a single element of type `P` (which is normally a reference).
+        template <typename P>
+        struct elem_holder : elem_holder_base
         {
-            // See below.
-            template <typename F, typename ...Q>
-            constexpr decltype(auto) apply(F &&func, Q &&... params) const
-            {
-                return static_cast<F &&>(func)(static_cast<Q &&>(params)...);
-            }
+            std::remove_reference_t<P> *target = nullptr;
+
+            BETTERLISTINIT_FORCEINLINE constexpr elem_holder(std::remove_reference_t<P> *target) : target(target) {}
         };
-        template <typename T>
-        struct tuple_impl_regular_low<T>
+
+        #if !BETTERLISTINIT_TUPLE_IMPL_V2
+        // A single element of our tuple. `I` is the element index, which keeps the bases of the tuple distinct.
+        template <size_t I, typename T>
+        struct tuple_leaf
         {
-            using first_t = std::remove_reference_t<T> *;
-            first_t first;
+            elem_holder<T> holder;
 
-            constexpr tuple_impl_regular_low(first_t first) : first(first) {}
+            BETTERLISTINIT_FORCEINLINE constexpr tuple_leaf(std::remove_reference_t<T> *target) : holder(target) {}
+        };
+        // A helper class for our tuple implementation.
+        // The elements are the bases, rather than nested members, so that everything below is a single pack expansion rather than recursion.
+        // This keeps the instantiation depth and the constexpr call depth constant, regardless of the list length.
+        template <typename Seq, typename ...P>
+        struct tuple_impl_regular_low;
+        template <size_t ...I, typename ...P>
+        struct tuple_impl_regular_low<index_sequence<I...>, P...> : tuple_leaf<I, P>...
+        {
+            BETTERLISTINIT_FORCEINLINE constexpr tuple_impl_regular_low(std::remove_reference_t<P> *... elems) : tuple_leaf<I, P>(elems)... {}
 
             // Returns an element type by its index.
-            template <size_t I>
-            using elem_t = T;
+            template <size_t J>
+            using elem_t = nth_type<J, P...>;
 
             // Returns an element by its index.
-            template <size_t I>
-            constexpr first_t get() const
+            template <size_t J>
+            BETTERLISTINIT_FORCEINLINE constexpr std::remove_reference_t<elem_t<J>> *get() const
             {
-                static_assert(I == 0, "Internal error: The tuple index is out of range.");
-                return first;
+                return static_cast<const tuple_leaf<J, elem_t<J>> &>(*this).holder.target;
             }
 
-            // Fills the array with the instances of `F::func<I>`.
-            template <typename F, size_t I = 0, typename E>
-            static constexpr void populate_func_array(E *array)
+            // Points `refs[i].holder` to the type-erased `i`th element.
+            template <typename R>
+            BETTERLISTINIT_FORCEINLINE constexpr void get_holders(R *refs) const
             {
-                *array = F::template func<I>;
+                int dummy[] = {0, (void(refs[I].holder = &static_cast<const tuple_leaf<I, P> &>(*this).holder), 0)...};
+                (void)dummy;
             }
 
             // Calls the function with the specified parameters, followed by the tuple elements.
-            // The extra parameters are normally the preceding tuple elements.
             template <typename F, typename ...Q>
-            constexpr decltype(auto) apply(F &&func, Q &&... params) const
-            {
-                return static_cast<F &&>(func)(static_cast<Q &&>(params)..., static_cast<T &&>(*first));
-            }
-        };
-        template <typename T, typename ...P>
-        struct tuple_impl_regular_low<T, P...>
-        {
-            using first_t = std::remove_reference_t<T> *;
-            first_t first;
-
-            using next_t = tuple_impl_regular_low<P...>;
-            next_t next;
-
-            constexpr tuple_impl_regular_low(first_t first, std::remove_reference_t<P> *... next) : first(first), next(next...) {}
-
-            template <size_t I>
-            using elem_t = std::conditional_t<I == 0, T, typename next_t::template elem_t<I-1>>;
-
-            template <size_t I, std::enable_if_t<I == 0, nullptr_t> = nullptr>
-            constexpr first_t get() const
-            {
-                return first;
-            }
-            template <size_t I, std::enable_if_t<(I > 0), nullptr_t> = nullptr>
-            constexpr decltype(next.template get<I-1>()) get() const
+            BETTERLISTINIT_FORCEINLINE constexpr decltype(auto) apply(F &&func, Q &&... params) const
             {
-                return next.template get<I-1>();
+                return static_cast<F &&>(func)(static_cast<Q &&>(params)..., static_cast<P &&>(*static_cast<const tuple_leaf<I, P> &>(*this).holder.target)...);
             }
 
-            template <typename F, size_t I = 0, typename E>
-            static constexpr void populate_func_array(E *array)
-            {
-                *array = F::template func<I>;
-                next_t::template populate_func_array<F, I+1>(array + 1);
-            }
-
-            template <typename F, typename ...Q>
-            constexpr decltype(auto) apply(F &&func, Q &&... params) const
-            {
-                return next.apply(static_cast<F &&>(func), static_cast<Q &&>(params)..., static_cast<T &&>(*first));
-            }
+            // An array of the instances of `F::func<I, P>`.
+            template <typename F, typename E>
+            struct func_array {E funcs[sizeof...(P) + 1] = {F::template func<I, P>..., nullptr};};
         };
         // The tuple implementation itself.
         template <typename ...P>
-        class tuple_impl_regular : tuple_impl_regular_low<P...>
+        class tuple_impl_regular : tuple_impl_regular_low<make_index_sequence<sizeof...(P)>, P...>
         {
-            using base_t = tuple_impl_regular_low<P...>;
+            using base_t = tuple_impl_regular_low<make_index_sequence<sizeof...(P)>, P...>;
 
             // Various helpers for `.apply()` defined below.
 
             template <typename F, typename ...Q>
             struct make_elem_func
             {
-                template <size_t I>
+                template <size_t I, typename T>
                 static constexpr typename F::return_type func(const base_t &base, Q &&... params)
                 {
-                    return F::template func<typename base_t::template elem_t<I>>(*base.template get<I>(), static_cast<Q &&>(params)...);
+                    return F::template func<T>(*static_cast<const tuple_leaf<I, T> &>(base).holder.target, static_cast<Q &&>(params)...);
                 }
             };
 
             template <typename F, typename ...Q>
-            struct elem_func_array {typename F::return_type (*funcs[sizeof...(P)])(const base_t &, Q &&...){};};
-
-            template <typename F, typename ...Q>
-            static constexpr elem_func_array<F, Q &&...> make_elem_func_array()
-            {
-                elem_func_array<F, Q &&...> ret;
-                base_t::template populate_func_array<make_elem_func<F, Q &&...>>(ret.funcs);
-                return ret;
-            }
+            using elem_func_array = typename base_t::template func_array<make_elem_func<F, Q...>, typename F::return_type (*)(const base_t &, Q...)>;
 
           public:
             using base_t::base_t;
 
+            // Returns the `I`th element, forwarded.
+            template <size_t I>
+            constexpr nth_type<I, P...> &&elem() const
+            {
+                return static_cast<nth_type<I, P...> &&>(*base_t::template get<I>());
+            }
+
             // Applies a custom function to the `i`th element.
             // `F` must have `::return_type` and `::func<T>(T &)`, where `T` receives the element type, and can be an rvalue reference.
             template <typename F, typename ...Q, std::enable_if_t<dependent_value<F, sizeof...(P) != 0>::value, nullptr_t> = nullptr>
             constexpr typename F::return_type apply_to_elem(size_t i, Q &&... params) const
             {
-                constexpr elem_func_array<F, Q &&...> array = make_elem_func_array<F, Q &&...>();
+                constexpr elem_func_array<F, Q &&...> array{};
                 return array.funcs[i](*this, static_cast<Q &&>(params)...);
             }
             template <typename F, typename ...Q, std::enable_if_t<dependent_value<F, sizeof...(P) == 0>::value, nullptr_t> = nullptr>
@@ -566,6 +921,9 @@ namespace better_list_init
 
             // Applies a custom function to all the elements at once. `params...` are prepended to the tuple elements.
             using base_t::apply; // decltype(auto) apply(F &&func, Q &&... params);
+
+            // Points `refs[i].holder` to the type-erased `i`th element (`detail::elem_holder<P>`), for each element.
+            using base_t::get_holders; // void get_holders(R *refs);
         };
         #else // if BETTERLISTINIT_TUPLE_IMPL_V2
         // The tuple implementation. This one needs constexpr `void *` cast to be constexpr.
@@ -590,6 +948,13 @@ namespace better_list_init
             }
 
           public:
+            // Returns the `I`th element, forwarded.
+            template <size_t I>
+            constexpr nth_type<I, P...> &&elem() const
+            {
+                return static_cast<nth_type<I, P...> &&>(*static_cast<std::remove_reference_t<nth_type<I, P...>> *>(const_cast<void *>(values[I])));
+            }
+
             // Applies a custom function to the `i`th element.
             // `F` must have `::return_type` and `::func<T>(T &)`, where `T` receives the element type, and can be an rvalue reference.
             template <typename F, typename ...Q, std::enable_if_t<dependent_value<F, sizeof...(P) != 0>::value, nullptr_t> = nullptr>
@@ -642,33 +1007,51 @@ namespace better_list_init
             // We want to keep this an aggregate, for simplicity.
             std::remove_reference_t<T> *values[N];
 
+            template <size_t I>
+            BETTERLISTINIT_FORCEINLINE constexpr T &&elem() const
+            {
+                return static_cast<T &&>(*values[I]);
+            }
+
             template <typename F, typename ...Q>
-            constexpr typename F::return_type apply_to_elem(size_t i, Q &&... params) const
+            BETTERLISTINIT_FORCEINLINE constexpr typename F::return_type apply_to_elem(size_t i, Q &&... params) const
             {
                 return F::template func<T>(*values[i], static_cast<Q &&>(params)...);
             }
 
-            template <size_t I = 0, typename F, typename ...Q, std::enable_if_t<I == N-1, nullptr_t> = nullptr>
-            constexpr decltype(auto) apply(F &&func, Q &&... params) const
+          private:
+            template <size_t ...I, typename F, typename ...Q>
+            BETTERLISTINIT_FORCEINLINE constexpr decltype(auto) apply_low(index_sequence<I...>, F &&func, Q &&... params) const
             {
-                return static_cast<F &&>(func)(static_cast<Q &&>(params)..., static_cast<T &&>(*values[I]));
+                return static_cast<F &&>(func)(static_cast<Q &&>(params)..., static_cast<T &&>(*values[I])...);
             }
-            template <size_t I = 0, typename F, typename ...Q, std::enable_if_t<I != N-1, nullptr_t> = nullptr>
-            constexpr decltype(auto) apply(F &&func, Q &&... params) const
+
+          public:
+            // A single pack expansion rather than recursion, to keep the constexpr call depth constant.
+            template <typename F, typename ...Q>
+            BETTERLISTINIT_FORCEINLINE constexpr decltype(auto) apply(F &&func, Q &&... params) const
             {
-                return apply<I+1>(static_cast<F &&>(func), static_cast<Q &&>(params)..., static_cast<T &&>(*values[I]));
+                return apply_low(make_index_sequence<N>{}, static_cast<F &&>(func), static_cast<Q &&>(params)...);
             }
         };
 
+        // Is `T` (possibly cv-qualified reference to) `type::when<U>`?
+        template <typename T> struct is_optional_elem : std::false_type {};
+        template <typename T> struct is_optional_elem<T &> : is_optional_elem<T> {};
+        template <typename T> struct is_optional_elem<T &&> : is_optional_elem<T> {};
+        template <typename T> struct is_optional_elem<const T> : is_optional_elem<T> {};
+        template <typename T> struct is_optional_elem<type::when<T>> : std::true_type {};
+
         // Selects an implementation for our tuple. If all element types are the same (and there is at least one),
         // a simplified array-based implementation is used.
+        // Except for optional elements, since those need the type-erasure support of the regular tuple (see `get_holders()`).
         template <typename Void, typename ...P>
         struct tuple_impl_selector
         {
             using type = tuple_impl_regular<P...>;
         };
         template <typename ...P>
-        struct tuple_impl_selector<std::enable_if_t<all_types_same<P...>::value && sizeof...(P) != 0>, P...>
+        struct tuple_impl_selector<std::enable_if_t<all_types_same<P...>::value && sizeof...(P) != 0 && !is_optional_elem<typename first_type<P...>::type>::value>, P...>
         {
             using type = tuple_impl_array<typename first_type<P...>::type, sizeof...(P)>;
         };
@@ -692,463 +1075,3613 @@ namespace better_list_init
         };
 
 
-        template <typename T>
-        struct construct_from_elem
+        // Constructs `List` from the arguments, casting each one to `R`.
+        template <typename R, typename List>
+        struct cast_elems_functor
         {
-            using return_type = T;
-            template <typename U>
-            static constexpr T func(U &source)
+            template <typename ...P>
+            constexpr List operator()(P &&... params) const noexcept
             {
-                return T(static_cast<U &&>(source));
+                // Note, not doing `return List(...);`. There's difference in C++14, when there's no mandatory copy elision.
+                return {static_cast<R>(static_cast<P &&>(params))...};
             }
         };
 
-        #if BETTERLISTINIT_ALLOCATOR_HACK
-        namespace allocator_hack
+        // Calls a function for each argument, left to right.
+        template <typename F>
+        struct for_each_functor
         {
-            // Constructs a `T` at `target` using allocator `A`, passing a forwarding reference to `U` as an argument.
-            template <typename T, typename A>
-            struct construct_from_elem_at
+            F &&func;
+
+            template <typename ...P>
+            constexpr void operator()(P &&... params) const
             {
-                using return_type = void;
-                template <typename U>
-                static constexpr void func(U &source, A &alloc, T *target)
-                {
-                    std::allocator_traits<A>::template construct(alloc, target, static_cast<U &&>(source));
-                }
-            };
-        }
-        #endif
+                #if BETTERLISTINIT_CXX_STANDARD >= 17
+                (void(func(static_cast<P &&>(params))), ...);
+                #else
+                // Braces guarantee the left-to-right evaluation.
+                int dummy[] = {0, (void(func(static_cast<P &&>(params))), 0)...};
+                (void)dummy;
+                #endif
+            }
+        };
 
-        // Our iterator's value type inherits from this.
-        struct elem_ref_base {};
 
-        // Replaces `std::is_constructible`. The standard trait is buggy at least in MSVC v19.32.
-        template <typename Void, typename T, typename ...P>
-        struct constructible_helper : std::false_type {};
-        template <typename T, typename ...P>
-        struct constructible_helper<decltype(void(T(std::declval<P>()...))), T, P...> : std::true_type {};
-        template <typename T, typename ...P>
-        struct constructible : constructible_helper<void, T, P...> {};
+        // Returns the argument as an lvalue.
+        template <typename T>
+        constexpr T &as_lvalue(T &&value) noexcept
+        {
+            return value;
+        }
 
-        template <typename T, typename ...P>
-        struct nothrow_constructible : std::integral_constant<bool, noexcept(T(declval<P>()...))> {};
+        // Returns the begin and end iterators of a range spliced into a list with `spread(range)`.
+        template <typename T>
+        constexpr auto spread_begin(T &range) -> decltype(range.begin()) {return range.begin();}
+        template <typename T, size_t N>
+        constexpr T *spread_begin(T (&range)[N]) noexcept {return range;}
+        template <typename T>
+        constexpr auto spread_end(T &range) -> decltype(range.end()) {return range.end();}
+        template <typename T, size_t N>
+        constexpr T *spread_end(T (&range)[N]) noexcept {return range + N;}
 
-        // Whether `T` is constructible from a pair of `Iter`s, possibly with extra arguments.
-        // `List` is the `init<...>` specialization performing the conversion.
-        template <typename Void, typename T, typename Iter, typename List, typename ...P>
-        struct constructible_from_iters_helper : std::false_type {};
-        template <typename T, typename Iter, typename List, typename ...P>
-        struct constructible_from_iters_helper<decltype(void(custom::construct_range<void, T, Iter, List, P...>{}(declval<Iter &&>(), declval<Iter &&>(), declval<P &&>()...))), T, Iter, List, P...> : std::true_type {};
-        template <typename T, typename Iter, typename List, typename ...P>
-        struct constructible_from_iters : constructible_from_iters_helper<void, T, Iter, List, P...> {};
+        // Whether `T` can be spliced into a list with `spread(range)`. We need random-access iterators to compute the size and to index the elements.
+        template <typename Void, typename T>
+        struct is_spreadable_helper : std::false_type {};
+        template <typename T>
+        struct is_spreadable_helper<decltype(void(spread_end(declval<T &>()) - spread_begin(declval<T &>())), void(*(spread_begin(declval<T &>()) + ptrdiff_t{}))), T> : std::true_type {};
+        template <typename T>
+        struct is_spreadable : is_spreadable_helper<void, std::remove_reference_t<T>> {};
 
-        template <typename T, typename Iter, typename List, typename ...P>
-        struct nothrow_constructible_from_iters : std::integral_constant<bool, noexcept(custom::construct_range<void, T, Iter, List, P...>{}(declval<Iter &&>(), declval<Iter &&>(), declval<P &&>()...))> {};
+        // The elements produced by `generate(n, func)` (see `type::generate` below).
+        // Converts to the result of `func(i)`, so if that's a prvalue of the target type, it's constructed directly in place.
+        template <typename F>
+        class generated_elem
+        {
+            std::remove_reference_t<F> *func = nullptr;
+            size_t index = 0;
 
-        // Whether `T` is constructible from a braced list of `P...`.
-        // `List` is the `init<...>` specialization performing the conversion.
-        template <typename Void, typename T, typename List, typename ...P>
-        struct nonrange_brace_constructible_helper : std::false_type {};
-        template <typename T, typename List, typename ...P>
-        struct nonrange_brace_constructible_helper<decltype(void(custom::construct_nonrange<void, T, List, P...>{}(declval<P>()...))), T, List, P...> : std::true_type {};
-        template <typename T, typename List, typename ...P>
-        struct nonrange_brace_constructible : nonrange_brace_constructible_helper<void, T, List, P...> {};
+          public:
+            using result_type = decltype(declval<std::remove_reference_t<F> &>()(size_t{}));
 
-        template <typename T, typename List, typename ...P>
-        struct nothrow_nonrange_brace_constructible : std::integral_constant<bool, noexcept(custom::construct_nonrange<void, T, List, P...>{}(declval<P>()...))> {};
+            constexpr generated_elem(std::remove_reference_t<F> &func, size_t index) noexcept
+                : func(&func), index(index)
+            {}
 
-        // Whether `T` is a valid target type for any conversion operator. We reject const types here.
-        // Normally this is not an issue, but GCC 10 in C++14 mode has quirky tendency to try to instantiate conversion operators to const types otherwise (for copy constructors?),
-        // which breaks when the types are non-copyable in a SFINAE-unfriendly way.
-        template <typename T>
-        using enable_if_valid_conversion_target = std::enable_if_t<!std::is_const<T>::value, int>;
-    }
+            // Calls the function.
+            BETTERLISTINIT_FORCEINLINE constexpr result_type get() const noexcept(noexcept(declval<std::remove_reference_t<F> &>()(size_t{})))
+            {
+                return (*func)(index);
+            }
 
-    // `better_list_init::type::init` is the type of our list class.
-    // I don't want to put it into `detail`, because it can be renamed by the user, and I don't want naming conflicts.
-    namespace type
+            BETTERLISTINIT_FORCEINLINE constexpr operator result_type() const noexcept(noexcept(declval<std::remove_reference_t<F> &>()(size_t{})))
+            {
+                return get();
+            }
+        };
+
+        // Describes how a list element expands into the elements of the target range.
+        // `T` is an element type, possibly a reference.
+        // Regular elements expand to themselves. The optional elements, created with `when(cond, expr)` (see `type::when` below), expand to zero or one element.
+        // The ranges spliced with `spread(range)` (see `type::spread` below) expand to their elements.
+        // `generate(n, func)` and `repeat(n, value)` (see `type::generate` and `type::repeat` below) expand to `n` elements.
+        template <typename T, typename Decayed = std::remove_cv_t<std::remove_reference_t<T>>>
+        struct elem_traits
+        {
+            // Whether this always expands to exactly one element.
+            static constexpr bool is_single = true;
+            // Whether this expands to a number of elements that's only known at runtime: a spliced range, or generated or repeated elements.
+            static constexpr bool is_spread = false;
+            // The type of the resulting elements.
+            using elem_type = T;
+            // The number of resulting elements.
+            BETTERLISTINIT_FORCEINLINE static constexpr size_t size(const std::remove_reference_t<T> &) noexcept {return 1;}
+            // Returns the `i`th resulting element.
+            BETTERLISTINIT_FORCEINLINE static constexpr T &&get(std::remove_reference_t<T> &elem, size_t = 0) noexcept {return static_cast<T &&>(elem);}
+        };
+        template <typename T, typename U>
+        struct elem_traits<T, type::when<U>>
+        {
+            static constexpr bool is_single = false;
+            static constexpr bool is_spread = false;
+            using elem_type = U;
+            BETTERLISTINIT_FORCEINLINE static constexpr size_t size(const type::when<U> &elem) noexcept {return elem.enabled();}
+            BETTERLISTINIT_FORCEINLINE static constexpr U &&get(const type::when<U> &elem, size_t = 0) noexcept {return elem.value();}
+        };
+        template <typename T, typename R>
+        struct elem_traits<T, type::spread<R>>
+        {
+          private:
+            using range_type = std::remove_reference_t<R>;
+            using iterator = decltype(spread_begin(declval<range_type &>()));
+            using iter_reference = decltype(*declval<const iterator &>());
+
+          public:
+            static constexpr bool is_single = false;
+            static constexpr bool is_spread = true;
+            // Move the elements out of rvalue ranges, unless the iterator returns prvalues.
+            using elem_type = std::conditional_t<!std::is_lvalue_reference<R>::value && std::is_lvalue_reference<iter_reference>::value, std::remove_reference_t<iter_reference> &&, iter_reference>;
+            BETTERLISTINIT_FORCEINLINE static constexpr size_t size(const type::spread<R> &elem)
+            {
+                range_type &range = as_lvalue(elem.range());
+                return size_t(spread_end(range) - spread_begin(range));
+            }
+            BETTERLISTINIT_FORCEINLINE static constexpr elem_type get(const type::spread<R> &elem, size_t i)
+            {
+                return static_cast<elem_type>(*(spread_begin(as_lvalue(elem.range())) + ptrdiff_t(i)));
+            }
+        };
+        template <typename T, typename F>
+        struct elem_traits<T, type::generate<F>>
+        {
+            static constexpr bool is_single = false;
+            static constexpr bool is_spread = true;
+            using elem_type = generated_elem<F>;
+            BETTERLISTINIT_FORCEINLINE static constexpr size_t size(const type::generate<F> &elem) noexcept {return elem.size();}
+            BETTERLISTINIT_FORCEINLINE static constexpr elem_type get(const type::generate<F> &elem, size_t i) noexcept {return elem_type(elem.func(), i);}
+        };
+        template <typename T, typename U>
+        struct elem_traits<T, type::repeat<U>>
+        {
+            static constexpr bool is_single = false;
+            static constexpr bool is_spread = true;
+            // The value is used several times, so it's always copied.
+            using elem_type = const std::remove_reference_t<U> &;
+            BETTERLISTINIT_FORCEINLINE static constexpr size_t size(const type::repeat<U> &elem) noexcept {return elem.size();}
+            BETTERLISTINIT_FORCEINLINE static constexpr elem_type get(const type::repeat<U> &elem, size_t = 0) noexcept {return elem.value();}
+        };
+
+        template <typename T> struct is_single_elem : std::integral_constant<bool, elem_traits<T>::is_single> {};
+        template <typename T> struct is_spread_elem : std::integral_constant<bool, elem_traits<T>::is_spread> {};
+    }
+
+    #if BETTERLISTINIT_TRACE
+    // Which code path was used to convert a list, see `trace_info`.
+    // `proxied` means lists with spliced ranges (see `spread(range)`) and transformed lists (see `.transform(f)`).
+    enum class trace_path {empty, homogeneous, heterogeneous, proxied, nonrange};
+
+    // How a range element was constructed from a list element: moved, copied (see `custom::is_element_copy`), or converted from a different type.
+    // Trivially copyable elements of the same type count as moved.
+    enum class trace_element_kind {move, copy, convert};
+
+    // Describes a list conversion, for `custom::trace_construct`.
+    struct trace_info
+    {
+        trace_path path = trace_path::empty;
+        // The number of elements in the target range (after skipping disabled optional elements and expanding spliced ranges),
+        // or the number of list elements for non-ranges.
+        detail::size_t size = 0;
+    };
+
+    // Tracing hooks, see `BETTERLISTINIT_TRACE`. Specialize those to collect statistics. They should not throw.
+    namespace custom
+    {
+        // `begin()` is called before converting a list of type `List` to `T`, and `end()` is called after it (even if it throws).
+        // `begin()` returns a token that's passed to `end()`, e.g. a timestamp. In C++20 it must be default-constructible.
+        template <typename Void, typename T, typename List>
+        struct trace_construct
+        {
+            static constexpr int begin(const trace_info &) noexcept {return 0;}
+            static constexpr void end(const trace_info &, int) noexcept {}
+        };
+
+        // Called when a range element `T` is constructed from a list, with its index in the range.
+        // For homogeneous lists this is called for all elements before constructing the range, since the range constructs them directly from our references.
+        // Not called for non-ranges.
+        template <typename Void, typename T>
+        struct trace_element
+        {
+            static constexpr void element(detail::size_t, trace_element_kind) noexcept {}
+        };
+    }
+    #endif
+
+    namespace detail
+    {
+        #if BETTERLISTINIT_TRACE
+        // Whether to call the tracing hooks. They are skipped during constant evaluation in C++20.
+        BETTERLISTINIT_FORCEINLINE BETTERLISTINIT_CONSTEXPR_TRACE bool trace_now() noexcept
+        {
+            #if BETTERLISTINIT_CXX_STANDARD >= 20
+            return !std::is_constant_evaluated();
+            #else
+            return true;
+            #endif
+        }
+
+        // How a range element `T` is constructed from a list element `U` (a reference), see `trace_element_kind`.
+        // If `Transformed` is true, the element first goes through `.transform(f)`, so it's always a conversion.
+        template <typename T, typename U, bool Transformed = false>
+        struct trace_kind
+        {
+            using source = std::remove_cv_t<std::remove_reference_t<U>>;
+            static constexpr trace_element_kind value =
+                Transformed || !(std::is_same<T, source>::value || (std::is_class<T>::value && std::is_base_of<T, source>::value)) ? trace_element_kind::convert :
+                custom::is_element_copy<T, U>::value ? trace_element_kind::copy : trace_element_kind::move;
+        };
+        // Generated elements are described by the result of the function.
+        template <typename T, typename F, bool Transformed>
+        struct trace_kind<T, generated_elem<F>, Transformed> : trace_kind<T, typename generated_elem<F>::result_type, Transformed> {};
+
+        // Calls `custom::trace_element` for a range element `T`.
+        template <typename T>
+        BETTERLISTINIT_FORCEINLINE BETTERLISTINIT_CONSTEXPR_TRACE void trace_element(size_t index, trace_element_kind kind) noexcept
+        {
+            if (trace_now())
+                custom::trace_element<void, T>::element(index, kind);
+        }
+
+        // Calls `custom::trace_construct` for converting a list `List` to `T`, for the lifetime of this object.
+        template <typename T, typename List>
+        class trace_scope
+        {
+            using hook = custom::trace_construct<void, T, List>;
+            trace_info info;
+            decltype(hook::begin(info)) token{};
+
+          public:
+            BETTERLISTINIT_FORCEINLINE BETTERLISTINIT_CONSTEXPR_TRACE trace_scope(trace_path path, size_t size) noexcept
+            {
+                info.path = path;
+                info.size = size;
+                if (trace_now())
+                    token = hook::begin(info);
+            }
+            trace_scope(const trace_scope &) = delete;
+            trace_scope &operator=(const trace_scope &) = delete;
+            BETTERLISTINIT_FORCEINLINE BETTERLISTINIT_CONSTEXPR_TRACE ~trace_scope()
+            {
+                if (trace_now())
+                    hook::end(info, token);
+            }
+        };
+        #endif
+
+        // Writes the indices of the non-empty elements to `indices`, and returns their number.
+        // Only the optional elements can be empty. Must not be used with spliced ranges.
+        struct enabled_indices_functor
+        {
+            size_t *indices;
+
+            template <typename ...P>
+            constexpr size_t operator()(P &&... params) const noexcept
+            {
+                const bool enabled[] = {elem_traits<P>::size(params) != 0 ...};
+                size_t count = 0;
+                for (size_t i = 0; i < sizeof...(P); i++)
+                {
+                    if (enabled[i])
+                        indices[count++] = i;
+                }
+                return count;
+            }
+        };
+
+        // Writes the cumulative sizes of the elements to `ends` (i.e. `ends[i]` is the position past the `i`th element in the expanded list),
+        // and returns the total size.
+        struct elem_ends_functor
+        {
+            size_t *ends;
+
+            template <typename ...P>
+            constexpr size_t operator()(P &&... params) const
+            {
+                // The leading zero is here to support empty lists.
+                const size_t sizes[] = {0, elem_traits<P>::size(params)...};
+                size_t total = 0;
+                for (size_t i = 0; i < sizeof...(P); i++)
+                {
+                    total += sizes[i + 1];
+                    ends[i] = total;
+                }
+                return total;
+            }
+        };
+
+        // Transformations applied to the elements before they're used to construct the target range elements.
+        // `pos` is the element index in the target range.
+
+        // Returns the element as is, except for `generated_elem`s, for which it returns the result of the function.
+        template <typename E>
+        BETTERLISTINIT_FORCEINLINE constexpr E &&unwrap_elem(E &&elem) noexcept
+        {
+            return static_cast<E &&>(elem);
+        }
+        template <typename F>
+        BETTERLISTINIT_FORCEINLINE constexpr typename generated_elem<F>::result_type unwrap_elem(generated_elem<F> &&elem) noexcept(noexcept(elem.get()))
+        {
+            return elem.get();
+        }
+
+        // No transformation, other than calling the functions of `generated_elem`s.
+        struct no_transform
+        {
+            template <typename E>
+            BETTERLISTINIT_FORCEINLINE constexpr decltype(auto) operator()(size_t, E &&elem) const noexcept(noexcept(unwrap_elem(static_cast<E &&>(elem))))
+            {
+                return unwrap_elem(static_cast<E &&>(elem));
+            }
+        };
+
+        // Calls `func(elem)`, or `func(pos, elem)` if `Indexed` is true. Used by `init{...}.transform(func)`.
+        template <typename F, bool Indexed>
+        struct transform_func
+        {
+            F *func = nullptr;
+
+            template <typename E, bool I = Indexed, std::enable_if_t<!I, nullptr_t> = nullptr>
+            BETTERLISTINIT_FORCEINLINE constexpr decltype(auto) operator()(size_t, E &&elem) const
+            {
+                return (*func)(unwrap_elem(static_cast<E &&>(elem)));
+            }
+            template <typename E, bool I = Indexed, std::enable_if_t<I, nullptr_t> = nullptr>
+            BETTERLISTINIT_FORCEINLINE constexpr decltype(auto) operator()(size_t pos, E &&elem) const
+            {
+                return (*func)(pos, unwrap_elem(static_cast<E &&>(elem)));
+            }
+        };
+        // Whether `T` can be constructed from an element of type `E`, after applying a transformation `Tr` to it.
+        template <typename Void, typename T, typename Tr, typename E>
+        struct transform_constructible_helper : std::false_type {};
+        template <typename T, typename Tr, typename E>
+        struct transform_constructible_helper<decltype(void(T(declval<const Tr &>()(size_t{}, declval<E>())))), T, Tr, E> : std::true_type {};
+        template <typename T, typename Tr, typename E>
+        struct transform_constructible : transform_constructible_helper<void, T, Tr, E> {};
+
+        template <typename T, typename Tr, typename E>
+        struct nothrow_transform_constructible : std::integral_constant<bool, noexcept(T(declval<const Tr &>()(size_t{}, declval<E>())))> {};
+
+        // If `T` is a `std::variant`, and `U` (possibly a reference) is exactly one of its alternatives (ignoring cv-qualifiers), `value` is true and `index` is its index.
+        // Then we construct `T` with `std::in_place_index`, instead of going through its converting constructor.
+        template <typename T, typename U>
+        struct variant_alternative
+        {
+            static constexpr bool value = false;
+        };
+        #if BETTERLISTINIT_VARIANT
+        template <typename ...A, typename U>
+        struct variant_alternative<std::variant<A...>, U>
+        {
+          private:
+            // Returns the index of `U` in `A...`, or `sizeof...(A)` if it's not there or isn't unique.
+            static constexpr size_t find() noexcept
+            {
+                constexpr bool same[] = {std::is_same<std::remove_cv_t<A>, std::remove_cv_t<std::remove_reference_t<U>>>::value..., false};
+                size_t ret = sizeof...(A);
+                for (size_t i = 0; i < sizeof...(A); i++)
+                {
+                    if (same[i])
+                    {
+                        if (ret != sizeof...(A))
+                            return sizeof...(A);
+                        ret = i;
+                    }
+                }
+                return ret;
+            }
+
+          public:
+            static constexpr size_t index = find();
+            static constexpr bool value = index != sizeof...(A);
+        };
+        #endif
+
+        // How to construct `T` from a (transformed) element of type `E`.
+        // `tags` is a `type_list` of the extra leading constructor arguments, which are value-initialized, and `arg_type` is what the element itself initializes.
+        // Normally there are no tags, and `arg_type` is `T`. But for `std::variant`s constructed from their alternatives (see `variant_alternative`),
+        // the tag is `std::in_place_index_t<I>`, and `arg_type` is the alternative.
+        template <typename T, typename E, typename = void>
+        struct elem_ctor_args
+        {
+            using tags = type_list<>;
+            using arg_type = T;
+        };
+        #if BETTERLISTINIT_VARIANT
+        template <typename T, typename E>
+        struct elem_ctor_args<T, E, std::enable_if_t<variant_alternative<T, E>::value>>
+        {
+            using tags = type_list<std::in_place_index_t<variant_alternative<T, E>::index>>;
+            using arg_type = std::variant_alternative_t<variant_alternative<T, E>::index, T>;
+        };
+        #endif
+
+        // The result of applying the transformation `Tr` to the element `i` of `U`.
+        template <typename U, typename Tr>
+        using transformed_elem_t = decltype(declval<const Tr &>()(size_t{}, elem_traits<U>::get(declval<U &>(), size_t{})));
+
+        template <typename T, typename Tr = no_transform>
+        struct construct_from_elem
+        {
+            using return_type = T;
+            // `i` is the index in the expanded element (see `elem_traits`), and `pos` is the index in the target range.
+            // If the transformation returns a prvalue `T`, it's constructed in place, thanks to the mandatory copy elision.
+            template <typename U>
+            BETTERLISTINIT_FORCEINLINE static constexpr T func(U &source, size_t i = 0, const Tr &transform = Tr{}, size_t pos = 0)
+            {
+                return make<U>(typename elem_ctor_args<T, transformed_elem_t<U, Tr>>::tags{}, source, i, transform, pos);
+            }
+
+            // `U` must be specified explicitly, since it can be a reference.
+            template <typename U, typename ...Tags>
+            BETTERLISTINIT_FORCEINLINE static constexpr T make(type_list<Tags...>, U &source, size_t i, const Tr &transform, size_t pos)
+            {
+                return T(Tags{}..., transform(pos, elem_traits<U>::get(source, i)));
+            }
+        };
+
+        // Constructs a `T` at `target` from an element, using placement-new. Unlike `construct_from_elem`, this doesn't need the mandatory copy elision.
+        template <typename T>
+        struct construct_elem_at
+        {
+            using return_type = void;
+            template <typename U>
+            static void func(U &source, T *target, size_t i = 0)
+            {
+                make<U>(typename elem_ctor_args<T, transformed_elem_t<U, no_transform>>::tags{}, source, target, i);
+            }
+
+            template <typename U, typename ...Tags>
+            static void make(type_list<Tags...>, U &source, T *target, size_t i)
+            {
+                ::new(placement_new_tag{}, (void *)target) T(Tags{}..., elem_traits<U>::get(source, i));
+            }
+        };
+
+        // Constructs the elements of a list as `T`s in uninitialized storage starting at `target`, and returns their number. See `init{...}.construct_at()`.
+        // If a constructor throws, destroys the already constructed elements.
+        template <typename T>
+        struct construct_at_functor
+        {
+            T *target = nullptr;
+
+            // Destroys the constructed elements when unwinding. Not using `try`/`catch`, to work without exceptions.
+            struct guard
+            {
+                T *target = nullptr;
+                size_t count = 0;
+                bool done = false;
+
+                explicit guard(T *target) noexcept : target(target) {}
+                guard(const guard &) = delete;
+                guard &operator=(const guard &) = delete;
+
+                ~guard()
+                {
+                    if (!done)
+                    {
+                        while (count > 0)
+                            target[--count].~T();
+                    }
+                }
+            };
+
+            template <typename U>
+            static void construct(guard &g, U &source)
+            {
+                for (size_t i = 0, n = elem_traits<U>::size(source); i < n; i++)
+                {
+                    construct_elem_at<T>::template func<U>(source, g.target + g.count, i);
+                    g.count++;
+                }
+            }
+
+            template <typename ...P>
+            size_t operator()(P &&... params) const
+            {
+                guard g(target);
+                // The braced list guarantees the left-to-right order.
+                const int dummy[] = {(construct<P &&>(g, params), 0)..., 0};
+                (void)dummy;
+                g.done = true;
+                return g.count;
+            }
+        };
+
+        #if BETTERLISTINIT_ALLOCATOR_HACK
+        namespace allocator_hack
+        {
+            // Converts to `T` by applying a transformation to an element.
+            // We pass this to the allocator instead of the transformation result, to preserve the copy elision.
+            template <typename T, typename Tr, typename E>
+            struct transformed_elem
+            {
+                const Tr &transform;
+                size_t pos;
+                E &&elem;
+
+                constexpr operator T() const
+                {
+                    return transform(pos, static_cast<E &&>(elem));
+                }
+            };
+
+            // Returns the argument for `allocator_traits<A>::construct()`.
+            template <typename T, typename E>
+            constexpr E &&construct_arg(const no_transform &, size_t, E &&elem) noexcept
+            {
+                return static_cast<E &&>(elem);
+            }
+            template <typename T, typename Tr, typename E>
+            constexpr transformed_elem<T, Tr, E> construct_arg(const Tr &transform, size_t pos, E &&elem) noexcept
+            {
+                return {transform, pos, static_cast<E &&>(elem)};
+            }
+            template <typename T, typename F>
+            constexpr transformed_elem<T, no_transform, generated_elem<F>> construct_arg(const no_transform &transform, size_t pos, generated_elem<F> &&elem) noexcept
+            {
+                return {transform, pos, static_cast<generated_elem<F> &&>(elem)};
+            }
+
+            // Constructs a `T` at `target` using allocator `A`, passing a forwarding reference to `U` (possibly transformed) as an argument.
+            template <typename T, typename A, typename Tr = no_transform>
+            struct construct_from_elem_at
+            {
+                using return_type = void;
+                template <typename U>
+                static constexpr void func(U &source, A &alloc, T *target, size_t i = 0, const Tr &transform = Tr{}, size_t pos = 0)
+                {
+                    using args = elem_ctor_args<T, transformed_elem_t<U, Tr>>;
+                    make<U, typename args::arg_type>(typename args::tags{}, source, alloc, target, i, transform, pos);
+                }
+
+                template <typename U, typename Arg, typename ...Tags>
+                static constexpr void make(type_list<Tags...>, U &source, A &alloc, T *target, size_t i, const Tr &transform, size_t pos)
+                {
+                    std::allocator_traits<A>::template construct(alloc, target, Tags{}..., construct_arg<Arg>(transform, pos, elem_traits<U>::get(source, i)));
+                }
+            };
+        }
+        #endif
+
+        // Our iterator's value type inherits from this.
+        struct elem_ref_base {};
+
+        template <typename T, bool Nothrow>
+        class elem_ref;
+
+        #if BETTERLISTINIT_ALLOCATOR_HACK
+        namespace allocator_hack
+        {
+            // Converts to `T` by converting an `elem_ref<T, ...>`. See `elem_ref::_allocator_hack_construct_at()`.
+            template <typename T, typename Ref>
+            struct erased_elem
+            {
+                const Ref *ref = nullptr;
+
+                constexpr operator T() const
+                {
+                    return *ref;
+                }
+            };
+        }
+        #endif
+
+        // Heterogeneous lists use this as the element type for the iterators.
+        // The elements are type-erased, so this (and the iterator) depend only on the target type, rather than on the whole list.
+        // `Nothrow` is true if all elements of the list can be converted to `T` without throwing.
+        template <typename T, bool Nothrow>
+        class elem_ref : elem_ref_base
+        {
+            template <typename ...P> friend class type::BETTERLISTINIT_IDENTIFIER;
+            template <typename Seq, typename ...P> friend struct tuple_impl_regular_low;
+
+            const elem_holder_base *holder = nullptr;
+            T (*construct)(const elem_holder_base &holder) = nullptr;
+            #if BETTERLISTINIT_TRACE
+            size_t index = 0;
+            trace_element_kind kind = trace_element_kind::move;
+            #endif
+
+            // Constructs `T` from an element of type `P`, pointed to by `holder`.
+            template <typename P>
+            BETTERLISTINIT_FORCEINLINE static constexpr T construct_elem(const elem_holder_base &holder) noexcept(Nothrow)
+            {
+                return construct_from_elem<T>::template func<P>(*static_cast<const elem_holder<P> &>(holder).target);
+            }
+
+            // The `construct` pointers for the elements of a list.
+            template <typename ...P>
+            struct construct_table
+            {
+                T (*funcs[sizeof...(P)])(const elem_holder_base &holder) = {&construct_elem<P>...};
+                #if BETTERLISTINIT_TRACE
+                trace_element_kind kinds[sizeof...(P)] = {trace_kind<T, P>::value...};
+                #endif
+            };
+
+            BETTERLISTINIT_FORCEINLINE constexpr elem_ref() {}
+
+          public:
+            // Non-copyable.
+            // The list creates and owns all its references, and exposes actual references to them.
+            // This is because pre-C++20 iterator requirements force us to return actual references from `*`, and more importantly `[]`.
+            elem_ref(const elem_ref &) = delete;
+            elem_ref &operator=(const elem_ref &) = delete;
+
+            // MSVC is bugged and refuses to let us default-construct references in some scenarios, despite `init` being our `friend`.
+            // We work around this by creating arrays here.
+            template <size_t N>
+            struct array
+            {
+                elem_ref elems[N];
+                BETTERLISTINIT_FORCEINLINE constexpr array() {}
+            };
+
+            BETTERLISTINIT_FORCEINLINE constexpr operator T() const noexcept(Nothrow)
+            {
+                #if BETTERLISTINIT_TRACE
+                detail::trace_element<T>(index, kind);
+                #endif
+                return construct(*holder);
+            }
+
+            #if BETTERLISTINIT_ALLOCATOR_HACK
+            // Constructs an object at the specified address, using an allocator.
+            // We don't know the allocator type when erasing the element, so we pass it an object converting to `T` instead, which preserves the copy elision.
+            template <typename Alloc>
+            BETTERLISTINIT_FORCEINLINE constexpr void _allocator_hack_construct_at(Alloc &alloc, T *location) const noexcept(Nothrow)
+            {
+                std::allocator_traits<Alloc>::template construct(alloc, location, allocator_hack::erased_elem<T, elem_ref>{this});
+            }
+            #endif
+        };
+
+        // Whether `T` is a character type, as in string literals.
+        template <typename T> struct is_char_type : std::false_type {};
+        template <> struct is_char_type<char> : std::true_type {};
+        template <> struct is_char_type<wchar_t> : std::true_type {};
+        template <> struct is_char_type<char16_t> : std::true_type {};
+        template <> struct is_char_type<char32_t> : std::true_type {};
+        #ifdef __cpp_char8_t
+        template <> struct is_char_type<char8_t> : std::true_type {};
+        #endif
+
+        // Whether `T` is an lvalue reference to a const array of characters, such as a string literal. If so, `char_type` is the character type.
+        template <typename T>
+        struct char_array_traits : std::false_type {using char_type = void;};
+        template <typename CharT, size_t N>
+        struct char_array_traits<const CharT (&)[N]> : is_char_type<CharT> {using char_type = CharT;};
+
+        // Whether `T` can be constructed from a pointer to `CharT` and a length, and also from just the pointer, like strings and string views.
+        // Lists of character arrays construct such elements from the pointer and the array size, instead of letting them call `strlen()`.
+        template <typename T, typename CharT, typename = void>
+        struct char_array_constructible : std::false_type {};
+        template <typename T, typename CharT>
+        struct char_array_constructible<T, CharT, std::enable_if_t<is_char_type<CharT>::value>>
+            : all_of<std::is_class<T>, std::is_constructible<T, const CharT *, size_t>, std::is_constructible<T, const CharT *>> {};
+
+        // Lists of character arrays (normally string literals) use this as the element type for the iterators, if `T` is `char_array_constructible`.
+        // Those lists are heterogeneous when the lengths differ, but this way they don't need the type erasure of `elem_ref`,
+        // and the elements are constructed from `(pointer, length)`. Computing the length is a runtime loop, but it's bounded by the array size, and is usually folded for literals.
+        template <typename T, typename CharT>
+        class char_array_ref : elem_ref_base
+        {
+            template <typename ...P> friend class type::BETTERLISTINIT_IDENTIFIER;
+            template <typename Ref> friend struct char_array_refs_functor;
+
+            const CharT *ptr = nullptr;
+            size_t size = 0;
+
+            // `n` is the array size. Like `strlen()`, we stop at the first null, but never read past the array.
+            BETTERLISTINIT_FORCEINLINE constexpr char_array_ref(const CharT *ptr, size_t n) noexcept : ptr(ptr)
+            {
+                while (size < n && ptr[size] != CharT{})
+                    size++;
+            }
+
+          public:
+            BETTERLISTINIT_FORCEINLINE constexpr char_array_ref() {}
+
+            BETTERLISTINIT_FORCEINLINE constexpr operator T() const noexcept(std::is_nothrow_constructible<T, const CharT *, size_t>::value)
+            {
+                return T(ptr, size);
+            }
+
+            #if BETTERLISTINIT_ALLOCATOR_HACK
+            // See `elem_ref::_allocator_hack_construct_at()`.
+            template <typename Alloc>
+            BETTERLISTINIT_FORCEINLINE constexpr void _allocator_hack_construct_at(Alloc &alloc, T *location) const noexcept(std::is_nothrow_constructible<T, const CharT *, size_t>::value)
+            {
+                std::allocator_traits<Alloc>::template construct(alloc, location, allocator_hack::erased_elem<T, char_array_ref>{this});
+            }
+            #endif
+        };
+
+        // Points `refs[i]` to the `i`th element, for lists of character arrays. See `char_array_ref`.
+        template <typename Ref>
+        struct char_array_refs_functor
+        {
+            Ref *refs;
+
+            template <typename ...P>
+            constexpr void operator()(P &&... arrays) const noexcept
+            {
+                Ref *ref = refs;
+                int dummy[] = {0, (void(*ref++ = Ref(arrays, std::extent<std::remove_reference_t<P>>::value)), 0)...};
+                (void)dummy;
+            }
+        };
+
+        // The iterator for non-empty lists without spliced ranges.
+        // If `R` is an `elem_ref<T, ...>`, iterates over an array of those (for heterogeneous lists).
+        // Otherwise iterates over an array of pointers to the elements, where `R` is the element type (for homogeneous lists).
+        // Either way, this depends only on the element type or on the target type, rather than on the whole list.
+        template <typename R>
+        struct elem_iter_traits
+        {
+            using stored_type = std::remove_reference_t<R> *;
+            using reference = R;
+            BETTERLISTINIT_FORCEINLINE static constexpr reference deref(const stored_type *ptr) noexcept {return static_cast<R>(**ptr);}
+        };
+        template <typename T, bool Nothrow>
+        struct elem_iter_traits<elem_ref<T, Nothrow>>
+        {
+            using stored_type = elem_ref<T, Nothrow>;
+            using reference = const elem_ref<T, Nothrow> &;
+            BETTERLISTINIT_FORCEINLINE static constexpr reference deref(const stored_type *ptr) noexcept {return *ptr;}
+        };
+
+        template <typename T, typename CharT>
+        struct elem_iter_traits<char_array_ref<T, CharT>>
+        {
+            using stored_type = char_array_ref<T, CharT>;
+            using reference = const char_array_ref<T, CharT> &;
+            BETTERLISTINIT_FORCEINLINE static constexpr reference deref(const stored_type *ptr) noexcept {return *ptr;}
+        };
+
+        template <typename R>
+        class elem_iter
+        {
+            template <typename ...P> friend class type::BETTERLISTINIT_IDENTIFIER;
+            using traits = elem_iter_traits<R>;
+            const typename traits::stored_type *ptr = nullptr;
+
+          public:
+            // Can't use C++20 iterator category auto-detection here, since an rvalue reference `reference` makes it think it's an input iterator.
+            // Yes, the detection logic is specified to not match the actual iterator requirements, this is LWG issue: https://cplusplus.github.io/LWG/issue3798
+            using iterator_category = std::random_access_iterator_tag;
+            // For C++20 concepts and `std::ranges` algorithms. They would guess the same from `iterator_category`, but we spell it out for clarity.
+            using iterator_concept = std::random_access_iterator_tag;
+            using reference = typename traits::reference;
+            using value_type = std::remove_cv_t<std::remove_reference_t<reference>>;
+            using pointer = void;
+            using difference_type = ptrdiff_t;
+
+            BETTERLISTINIT_FORCEINLINE constexpr elem_iter() noexcept {}
+
+            // `LegacyForwardIterator` requires us to return an actual reference here.
+            BETTERLISTINIT_FORCEINLINE constexpr reference operator*() const noexcept {return traits::deref(ptr);}
+
+            // No `operator->`. This causes C++20 `std::iterator_traits` to guess `pointer_type == void`, which sounds ok to me.
+
+            // Don't want to rely on `<compare>`.
+            friend BETTERLISTINIT_FORCEINLINE constexpr bool operator==(elem_iter a, elem_iter b) noexcept
+            {
+                return a.ptr == b.ptr;
+            }
+            friend BETTERLISTINIT_FORCEINLINE constexpr bool operator!=(elem_iter a, elem_iter b) noexcept
+            {
+                return !(a == b);
+            }
+            friend BETTERLISTINIT_FORCEINLINE constexpr bool operator<(elem_iter a, elem_iter b) noexcept
+            {
+                // Don't want to include `<functional>` for `std::less`, so need to cast to an integer to avoid UB.
+                return uintptr_t(a.ptr) < uintptr_t(b.ptr);
+            }
+            friend BETTERLISTINIT_FORCEINLINE constexpr bool operator> (elem_iter a, elem_iter b) noexcept {return b < a;}
+            friend BETTERLISTINIT_FORCEINLINE constexpr bool operator<=(elem_iter a, elem_iter b) noexcept {return !(b < a);}
+            friend BETTERLISTINIT_FORCEINLINE constexpr bool operator>=(elem_iter a, elem_iter b) noexcept {return !(a < b);}
+
+            BETTERLISTINIT_FORCEINLINE constexpr elem_iter &operator++() noexcept
+            {
+                ++ptr;
+                return *this;
+            }
+            BETTERLISTINIT_FORCEINLINE constexpr elem_iter &operator--() noexcept
+            {
+                --ptr;
+                return *this;
+            }
+            BETTERLISTINIT_FORCEINLINE constexpr elem_iter operator++(int) noexcept
+            {
+                elem_iter ret = *this;
+                ++*this;
+                return ret;
+            }
+            BETTERLISTINIT_FORCEINLINE constexpr elem_iter operator--(int) noexcept
+            {
+                elem_iter ret = *this;
+                --*this;
+                return ret;
+            }
+            BETTERLISTINIT_FORCEINLINE constexpr friend elem_iter operator+(elem_iter it, ptrdiff_t n) noexcept {it += n; return it;}
+            BETTERLISTINIT_FORCEINLINE constexpr friend elem_iter operator+(ptrdiff_t n, elem_iter it) noexcept {it += n; return it;}
+            BETTERLISTINIT_FORCEINLINE constexpr friend elem_iter operator-(elem_iter it, ptrdiff_t n) noexcept {it -= n; return it;}
+            // There's no `number - iterator`.
+
+            BETTERLISTINIT_FORCEINLINE constexpr friend ptrdiff_t operator-(elem_iter a, elem_iter b) noexcept {return a.ptr - b.ptr;}
+
+            BETTERLISTINIT_FORCEINLINE constexpr elem_iter &operator+=(ptrdiff_t n) noexcept {ptr += n; return *this;}
+            BETTERLISTINIT_FORCEINLINE constexpr elem_iter &operator-=(ptrdiff_t n) noexcept {ptr -= n; return *this;}
+
+            BETTERLISTINIT_FORCEINLINE constexpr reference operator[](ptrdiff_t i) const noexcept
+            {
+                return *(*this + i);
+            }
+        };
+
+        // Replaces `std::is_constructible`. The standard trait is buggy at least in MSVC v19.32.
+        template <typename Void, typename T, typename ...P>
+        struct constructible_helper : std::false_type {};
+        template <typename T, typename ...P>
+        struct constructible_helper<decltype(void(T(std::declval<P>()...))), T, P...> : std::true_type {};
+        template <typename T, typename ...P>
+        struct constructible : constructible_helper<void, T, P...> {};
+
+        template <typename T, typename ...P>
+        struct nothrow_constructible : std::integral_constant<bool, noexcept(T(declval<P>()...))> {};
+
+        // Whether `T` is constructible from a pair of `Iter`s, possibly with extra arguments.
+        // `List` is the `init<...>` specialization performing the conversion.
+        template <typename Void, typename T, typename Iter, typename List, typename ...P>
+        struct constructible_from_iters_helper : std::false_type {};
+        template <typename T, typename Iter, typename List, typename ...P>
+        struct constructible_from_iters_helper<decltype(void(custom::construct_range<void, T, Iter, List, P...>{}(declval<Iter &&>(), declval<Iter &&>(), declval<P &&>()...))), T, Iter, List, P...> : std::true_type {};
+        template <typename T, typename Iter, typename List, typename ...P>
+        struct constructible_from_iters : constructible_from_iters_helper<void, T, Iter, List, P...> {};
+
+        template <typename T, typename Iter, typename List, typename ...P>
+        struct nothrow_constructible_from_iters : std::integral_constant<bool, noexcept(custom::construct_range<void, T, Iter, List, P...>{}(declval<Iter &&>(), declval<Iter &&>(), declval<P &&>()...))> {};
+
+        // Whether `T` is constructible from a braced list of `P...`.
+        // `List` is the `init<...>` specialization performing the conversion.
+        template <typename Void, typename T, typename List, typename ...P>
+        struct nonrange_brace_constructible_helper : std::false_type {};
+        template <typename T, typename List, typename ...P>
+        struct nonrange_brace_constructible_helper<decltype(void(custom::construct_nonrange<void, T, List, P...>{}(declval<P>()...))), T, List, P...> : std::true_type {};
+        template <typename T, typename List, typename ...P>
+        struct nonrange_brace_constructible : nonrange_brace_constructible_helper<void, T, List, P...> {};
+
+        template <typename T, typename List, typename ...P>
+        struct nothrow_nonrange_brace_constructible : std::integral_constant<bool, noexcept(custom::construct_nonrange<void, T, List, P...>{}(declval<P>()...))> {};
+
+        // Whether `T` is a valid target type for any conversion operator. We reject const types here.
+        // Normally this is not an issue, but GCC 10 in C++14 mode has quirky tendency to try to instantiate conversion operators to const types otherwise (for copy constructors?),
+        // which breaks when the types are non-copyable in a SFINAE-unfriendly way.
+        template <typename T>
+        using enable_if_valid_conversion_target = std::enable_if_t<!std::is_const<T>::value, int>;
+    }
+
+    #if BETTERLISTINIT_PARALLEL || BETTERLISTINIT_PADDED || BETTERLISTINIT_BOXED
+    namespace detail
+    {
+        // Owns an uninitialized memory block. This is the storage for `fixed_buffer`, `padded_buffer` and `poly_buffer`, which manage the objects in it.
+        // Over-allocates and aligns manually, since `operator new` doesn't support the extended alignment before C++17.
+        class raw_storage
+        {
+            void *memory = nullptr;
+            unsigned char *block = nullptr;
+
+          public:
+            constexpr raw_storage() noexcept {}
+
+            // Allocates `size` bytes aligned to `align`, which must be a power of two. Allocates nothing if `size` is zero.
+            raw_storage(size_t size, size_t align)
+            {
+                if (size == 0)
+                    return;
+                size_t extra = align > alignof(void *) ? align - 1 : 0;
+                memory = ::operator new(size + extra);
+                block = reinterpret_cast<unsigned char *>((reinterpret_cast<uintptr_t>(memory) + extra) & ~uintptr_t(extra));
+            }
+
+            raw_storage(raw_storage &&other) noexcept
+                : memory(other.memory), block(other.block)
+            {
+                other.memory = nullptr;
+                other.block = nullptr;
+            }
+            raw_storage &operator=(raw_storage &&other) noexcept
+            {
+                if (this != &other)
+                {
+                    free(memory);
+                    memory = other.memory;
+                    block = other.block;
+                    other.memory = nullptr;
+                    other.block = nullptr;
+                }
+                return *this;
+            }
+
+            ~raw_storage()
+            {
+                free(memory);
+            }
+
+            // The aligned block, or null if nothing was allocated.
+            unsigned char *data() const noexcept {return block;}
+
+            // Gives up the ownership of the memory. Returns a pointer to pass to `free()` later.
+            void *release() noexcept
+            {
+                void *ret = memory;
+                memory = nullptr;
+                block = nullptr;
+                return ret;
+            }
+
+            // Frees the result of `release()`. Does nothing for null pointers.
+            static void free(void *memory) noexcept
+            {
+                ::operator delete(memory);
+            }
+        };
+    }
+    #endif
+
+    #if BETTERLISTINIT_PARALLEL
+    // Options for `init{...}.parallel(...)`.
+    struct parallel_options
+    {
+        // The number of threads to use, including the calling one. Zero means `std::thread::hardware_concurrency()`.
+        unsigned threads = 0;
+    };
+
+    namespace detail
+    {
+        // Calls `func(i)` for every `i` in `[0, n)`, using up to `threads` threads (zero = the hardware concurrency), including the calling one.
+        // The indices are handed out one by one from a shared counter, so a thread that finishes early picks up more work,
+        // and a few slow elements don't stall the rest.
+        // If `func` throws, the remaining indices are skipped, and the first exception is rethrown after all threads are joined.
+        // If a thread fails to start, the already started ones stop taking new indices and are joined, then the error is rethrown.
+        template <typename F>
+        void parallel_for(size_t n, unsigned threads, F &&func)
+        {
+            if (threads == 0)
+                threads = std::thread::hardware_concurrency();
+            if (threads > n)
+                threads = unsigned(n);
+
+            std::atomic<size_t> next_index{0};
+            std::atomic<bool> failed{false};
+            std::exception_ptr exception;
+
+            auto work = [&]() noexcept
+            {
+                size_t i;
+                while (!failed.load(std::memory_order_relaxed) && (i = next_index.fetch_add(1, std::memory_order_relaxed)) < n)
+                {
+                    try
+                    {
+                        func(i);
+                    }
+                    catch (...)
+                    {
+                        // Only the first thread to fail records its exception.
+                        if (!failed.exchange(true))
+                            exception = std::current_exception();
+                    }
+                }
+            };
+
+            if (threads > 1)
+            {
+                struct joiner
+                {
+                    std::unique_ptr<std::thread[]> list;
+                    unsigned count = 0;
+
+                    ~joiner()
+                    {
+                        for (unsigned i = 0; i < count; i++)
+                            list[i].join();
+                    }
+                };
+                joiner extra_threads;
+                extra_threads.list.reset(new std::thread[threads - 1]);
+                try
+                {
+                    while (extra_threads.count < threads - 1)
+                    {
+                        extra_threads.list[extra_threads.count] = std::thread(work);
+                        extra_threads.count++;
+                    }
+                }
+                catch (...)
+                {
+                    // `joiner` joins the started threads when unwinding. The caller destroys the elements they've constructed.
+                    failed.store(true);
+                    throw;
+                }
+
+                work();
+            }
+            else
+            {
+                work();
+            }
+
+            // The threads are joined at this point, which synchronizes with their writes to `exception`.
+            if (exception)
+                std::rethrow_exception(exception);
+        }
+    }
+
+    // Destroys the elements of a `fixed_buffer` and frees its memory, see `fixed_buffer::release()`.
+    template <typename T>
+    struct fixed_buffer_deleter
+    {
+        // The memory to free, see `detail::raw_storage::release()`.
+        void *memory = nullptr;
+        detail::size_t count = 0;
+
+        void operator()(T *ptr) const noexcept
+        {
+            for (detail::size_t i = count; i-- > 0;)
+                ptr[i].~T();
+            detail::raw_storage::free(memory);
+        }
+    };
+
+    // A fixed-size array, with the size determined at runtime.
+    // Unlike `std::vector`, it doesn't need the elements to be movable, so it can hold elements constructed in place by `init{...}`.
+    // `init{...}.parallel()` constructs its elements directly in its storage, on several threads.
+    template <typename T>
+    class fixed_buffer
+    {
+        detail::raw_storage storage;
+        detail::size_t count = 0;
+
+        T *elems() const noexcept {return reinterpret_cast<T *>(storage.data());}
+
+        // Destroys the first `count` elements. The memory is freed by `storage`.
+        void destroy() noexcept
+        {
+            T *p = elems();
+            for (detail::size_t i = count; i-- > 0;)
+                p[i].~T();
+        }
+
+      public:
+        using value_type = T;
+        using size_type = detail::size_t;
+        using difference_type = detail::ptrdiff_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using iterator = T *;
+        using const_iterator = const T *;
+
+        constexpr fixed_buffer() noexcept {}
+
+        // Constructs the elements from a random-access range, one by one.
+        template <typename Iter, decltype(void(*detail::declval<Iter &>()), detail::nullptr_t{}) = nullptr>
+        fixed_buffer(Iter begin, Iter end)
+            : storage(detail::size_t(end - begin) * sizeof(T), alignof(T))
+        {
+            detail::size_t n = detail::size_t(end - begin);
+            T *p = elems();
+            try
+            {
+                for (; count < n; count++, ++begin)
+                    ::new((void *)(p + count)) T(*begin);
+            }
+            catch (...)
+            {
+                destroy();
+                throw;
+            }
+        }
+
+        // Constructs the elements from a random-access range, on several threads. Each element is read from the range exactly once.
+        // If any element throws, the already constructed ones are destroyed, and the first exception is rethrown.
+        // (Note that the elements that were moved from can't be restored.)
+        template <typename Iter, decltype(void(*detail::declval<Iter &>()), detail::nullptr_t{}) = nullptr>
+        fixed_buffer(Iter begin, Iter end, parallel_options options)
+            : storage(detail::size_t(end - begin) * sizeof(T), alignof(T))
+        {
+            detail::size_t n = detail::size_t(end - begin);
+            if (n == 0)
+                return;
+            T *p = elems();
+            std::unique_ptr<bool[]> constructed(new bool[n]());
+            try
+            {
+                detail::parallel_for(n, options.threads, [&](detail::size_t i)
+                {
+                    ::new((void *)(p + i)) T(begin[detail::ptrdiff_t(i)]);
+                    constructed[i] = true;
+                });
+            }
+            catch (...)
+            {
+                for (detail::size_t i = n; i-- > 0;)
+                {
+                    if (constructed[i])
+                        p[i].~T();
+                }
+                throw;
+            }
+            count = n;
+        }
+
+        fixed_buffer(fixed_buffer &&other) noexcept
+            : storage(static_cast<detail::raw_storage &&>(other.storage)), count(other.count)
+        {
+            other.count = 0;
+        }
+        fixed_buffer &operator=(fixed_buffer &&other) noexcept
+        {
+            if (this != &other)
+            {
+                destroy();
+                storage = static_cast<detail::raw_storage &&>(other.storage);
+                count = other.count;
+                other.count = 0;
+            }
+            return *this;
+        }
+
+        ~fixed_buffer()
+        {
+            destroy();
+        }
+
+        BETTERLISTINIT_NODISCARD detail::size_t size() const noexcept {return count;}
+        BETTERLISTINIT_NODISCARD bool empty() const noexcept {return count == 0;}
+
+        BETTERLISTINIT_NODISCARD T *data() noexcept {return elems();}
+        BETTERLISTINIT_NODISCARD const T *data() const noexcept {return elems();}
+
+        BETTERLISTINIT_NODISCARD T *begin() noexcept {return elems();}
+        BETTERLISTINIT_NODISCARD const T *begin() const noexcept {return elems();}
+        BETTERLISTINIT_NODISCARD T *end() noexcept {return elems() + count;}
+        BETTERLISTINIT_NODISCARD const T *end() const noexcept {return elems() + count;}
+
+        BETTERLISTINIT_NODISCARD T &operator[](detail::size_t i) noexcept {return elems()[i];}
+        BETTERLISTINIT_NODISCARD const T &operator[](detail::size_t i) const noexcept {return elems()[i];}
+
+        // Transfers the ownership of the elements to a `std::unique_ptr`, leaving the buffer empty.
+        BETTERLISTINIT_NODISCARD std::unique_ptr<T[], fixed_buffer_deleter<T>> release() noexcept
+        {
+            T *p = elems();
+            fixed_buffer_deleter<T> deleter{storage.release(), count};
+            count = 0;
+            return std::unique_ptr<T[], fixed_buffer_deleter<T>>(p, deleter);
+        }
+    };
+
+    namespace custom
+    {
+        // `fixed_buffer` has no `std::initializer_list` constructor, but it's fine to initialize it implicitly.
+        template <typename T, typename ...P>
+        struct allow_implicit_range_init<void, fixed_buffer<T>, P...> : std::true_type {};
+    }
+
+    namespace detail
+    {
+        template <typename T>
+        struct is_fixed_buffer : std::false_type {};
+        template <typename T>
+        struct is_fixed_buffer<fixed_buffer<T>> : std::true_type {};
+
+        // Describes how `init{...}.parallel()` constructs `T`.
+        // First, `builder` (a range) is constructed from the list on several threads, then it's converted to `T` using `finish()`.
+        // `allow_implicit` controls whether the conversion is implicit.
+        template <typename T, typename = void>
+        struct parallel_target {};
+
+        // By default, the elements are constructed in a `fixed_buffer`, then moved to the target range.
+        // Standard containers don't let us construct elements directly in their storage, so this is the best we can do.
+        template <typename T>
+        struct parallel_target<T, std::enable_if_t<custom::is_range<T>::value && !is_fixed_buffer<T>::value && constructible<T, std::move_iterator<typename custom::element_type<T>::type *>, std::move_iterator<typename custom::element_type<T>::type *>>::value>>
+        {
+            using builder = fixed_buffer<typename custom::element_type<T>::type>;
+            static constexpr bool allow_implicit = custom::allow_implicit_range_init<void, T>::value;
+
+            static T finish(builder &&buffer)
+            {
+                return T(std::make_move_iterator(buffer.begin()), std::make_move_iterator(buffer.end()));
+            }
+        };
+        // `fixed_buffer` is constructed in place.
+        template <typename T>
+        struct parallel_target<fixed_buffer<T>>
+        {
+            using builder = fixed_buffer<T>;
+            static constexpr bool allow_implicit = true;
+
+            static fixed_buffer<T> finish(builder &&buffer) noexcept
+            {
+                return static_cast<builder &&>(buffer);
+            }
+        };
+        // `std::unique_ptr<T[], fixed_buffer_deleter<T>>` takes over a `fixed_buffer`.
+        // Plain `std::unique_ptr<T[]>` isn't supported, since `std::default_delete<T[]>` needs the array to come from `new[]`,
+        // which would default-construct the elements before we could construct them.
+        template <typename T>
+        struct parallel_target<std::unique_ptr<T[], fixed_buffer_deleter<T>>>
+        {
+            using builder = fixed_buffer<T>;
+            static constexpr bool allow_implicit = true;
+
+            static std::unique_ptr<T[], fixed_buffer_deleter<T>> finish(builder &&buffer) noexcept
+            {
+                return buffer.release();
+            }
+        };
+    }
+    #endif
+
+    #if BETTERLISTINIT_ARENA
+    // A container `T` that owns its memory resource, see `init{...}.in_arena()`.
+    // `T` must use `std::pmr::polymorphic_allocator` (e.g. `std::pmr::map<K, V>`).
+    // The resource is heap-allocated, so the container can be moved around without invalidating it.
+    // Not move-assignable, because the container would keep the allocator of the old arena.
+    template <typename T>
+    class arena
+    {
+        std::unique_ptr<std::pmr::monotonic_buffer_resource> memory;
+        T value;
+
+      public:
+        // Creates a resource with the initial buffer of `buffer_size` bytes (allocated on the first use), then constructs the container as `make(resource)`.
+        // If the buffer runs out, more memory is requested from `std::pmr::get_default_resource()`.
+        template <typename F>
+        arena(detail::size_t buffer_size, F &&make)
+            : memory(std::make_unique<std::pmr::monotonic_buffer_resource>(buffer_size < 1 ? 1 : buffer_size)),
+            value(static_cast<F &&>(make)(static_cast<std::pmr::memory_resource *>(memory.get())))
+        {}
+
+        arena(arena &&) = default;
+        arena &operator=(arena &&) = delete;
+
+        // The resource used by the container. Can be used to add more elements to the same buffer.
+        BETTERLISTINIT_NODISCARD std::pmr::memory_resource *resource() const noexcept {return memory.get();}
+
+        BETTERLISTINIT_NODISCARD T &get() noexcept {return value;}
+        BETTERLISTINIT_NODISCARD const T &get() const noexcept {return value;}
+        BETTERLISTINIT_NODISCARD T &operator*() noexcept {return value;}
+        BETTERLISTINIT_NODISCARD const T &operator*() const noexcept {return value;}
+        BETTERLISTINIT_NODISCARD T *operator->() noexcept {return &value;}
+        BETTERLISTINIT_NODISCARD const T *operator->() const noexcept {return &value;}
+    };
+
+    namespace detail
+    {
+        // Estimates how many bytes `n` elements of container `T` need in an arena.
+        // Node-based containers store a few pointers next to each element, and unordered ones also have a bucket array, so we reserve 4 pointers per element.
+        // This overestimates for contiguous containers, which is harmless.
+        template <typename T>
+        constexpr size_t arena_size(size_t n) noexcept
+        {
+            constexpr size_t align = alignof(std::max_align_t);
+            constexpr size_t node_size = (sizeof(typename custom::element_type<T>::type) + 4 * sizeof(void *) + align - 1) / align * align;
+            return n * node_size;
+        }
+    }
+    #endif
+
+    #if BETTERLISTINIT_PADDED
+    // A fixed-size array, with the size determined at runtime, where each element starts at a multiple of `Align` bytes, and no two elements share an `Align`-byte block.
+    // By default `Align` is the cache line size, so this is useful for per-thread or per-shard counters, to avoid false sharing between neighboring elements:
+    // `padded_buffer<std::atomic_int> counters = init{repeat(n, 0)};`.
+    // Like `fixed_buffer`, it doesn't need the elements to be movable, so they can be constructed in place by `init{...}`.
+    template <typename T, detail::size_t Align = BETTERLISTINIT_CACHE_LINE_SIZE>
+    class padded_buffer
+    {
+        static_assert(Align != 0 && (Align & (Align - 1)) == 0, "The alignment must be a power of two.");
+
+        static constexpr detail::size_t slot_align = Align < alignof(T) ? alignof(T) : Align;
+
+      public:
+        // The distance between the neighboring elements, in bytes.
+        static constexpr detail::size_t stride = (sizeof(T) + slot_align - 1) / slot_align * slot_align;
+
+      private:
+        // The first element is at the beginning of the storage.
+        detail::raw_storage storage;
+        detail::size_t count = 0;
+
+        T *elem(detail::size_t i) const noexcept {return reinterpret_cast<T *>(storage.data() + i * stride);}
+
+        // Destroys the first `count` elements. The memory is freed by `storage`.
+        void destroy() noexcept
+        {
+            for (detail::size_t i = count; i-- > 0;)
+                elem(i)->~T();
+        }
+
+        // The iterator. Steps over the padding between the elements.
+        template <typename U>
+        class iterator_low
+        {
+            friend padded_buffer;
+            template <typename> friend class iterator_low;
+            using byte = std::conditional_t<std::is_const<U>::value, const unsigned char, unsigned char>;
+            byte *pos = nullptr;
+
+            constexpr iterator_low(byte *pos) noexcept : pos(pos) {}
+
+          public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using reference = U &;
+            using pointer = U *;
+            using difference_type = detail::ptrdiff_t;
+
+            constexpr iterator_low() noexcept {}
+
+            // Non-const to const conversion.
+            template <typename V, std::enable_if_t<std::is_same<const V, U>::value && !std::is_same<V, U>::value, detail::nullptr_t> = nullptr>
+            constexpr iterator_low(iterator_low<V> other) noexcept : pos(other.pos) {}
+
+            U &operator*() const noexcept {return *reinterpret_cast<U *>(pos);}
+            U *operator->() const noexcept {return reinterpret_cast<U *>(pos);}
+            U &operator[](detail::ptrdiff_t i) const noexcept {return *(*this + i);}
+
+            friend constexpr bool operator==(iterator_low a, iterator_low b) noexcept {return a.pos == b.pos;}
+            friend constexpr bool operator!=(iterator_low a, iterator_low b) noexcept {return a.pos != b.pos;}
+            friend constexpr bool operator< (iterator_low a, iterator_low b) noexcept {return a.pos < b.pos;}
+            friend constexpr bool operator> (iterator_low a, iterator_low b) noexcept {return b < a;}
+            friend constexpr bool operator<=(iterator_low a, iterator_low b) noexcept {return !(b < a);}
+            friend constexpr bool operator>=(iterator_low a, iterator_low b) noexcept {return !(a < b);}
+
+            constexpr iterator_low &operator++() noexcept {pos += stride; return *this;}
+            constexpr iterator_low &operator--() noexcept {pos -= stride; return *this;}
+            constexpr iterator_low operator++(int) noexcept {iterator_low ret = *this; ++*this; return ret;}
+            constexpr iterator_low operator--(int) noexcept {iterator_low ret = *this; --*this; return ret;}
+            constexpr iterator_low &operator+=(detail::ptrdiff_t n) noexcept {pos += n * detail::ptrdiff_t(stride); return *this;}
+            constexpr iterator_low &operator-=(detail::ptrdiff_t n) noexcept {pos -= n * detail::ptrdiff_t(stride); return *this;}
+            friend constexpr iterator_low operator+(iterator_low it, detail::ptrdiff_t n) noexcept {it += n; return it;}
+            friend constexpr iterator_low operator+(detail::ptrdiff_t n, iterator_low it) noexcept {it += n; return it;}
+            friend constexpr iterator_low operator-(iterator_low it, detail::ptrdiff_t n) noexcept {it -= n; return it;}
+            friend constexpr detail::ptrdiff_t operator-(iterator_low a, iterator_low b) noexcept {return (a.pos - b.pos) / detail::ptrdiff_t(stride);}
+        };
+
+      public:
+        using value_type = T;
+        using size_type = detail::size_t;
+        using difference_type = detail::ptrdiff_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using iterator = iterator_low<T>;
+        using const_iterator = iterator_low<const T>;
+
+        constexpr padded_buffer() noexcept {}
+
+        // Constructs the elements from a random-access range, one by one.
+        template <typename Iter, decltype(void(*detail::declval<Iter &>()), detail::nullptr_t{}) = nullptr>
+        padded_buffer(Iter begin, Iter end)
+            : storage(detail::size_t(end - begin) * stride, slot_align)
+        {
+            detail::size_t n = detail::size_t(end - begin);
+            try
+            {
+                for (; count < n; count++, ++begin)
+                    ::new((void *)elem(count)) T(*begin);
+            }
+            catch (...)
+            {
+                destroy();
+                throw;
+            }
+        }
+
+        padded_buffer(padded_buffer &&other) noexcept
+            : storage(static_cast<detail::raw_storage &&>(other.storage)), count(other.count)
+        {
+            other.count = 0;
+        }
+        padded_buffer &operator=(padded_buffer &&other) noexcept
+        {
+            if (this != &other)
+            {
+                destroy();
+                storage = static_cast<detail::raw_storage &&>(other.storage);
+                count = other.count;
+                other.count = 0;
+            }
+            return *this;
+        }
+
+        ~padded_buffer()
+        {
+            destroy();
+        }
+
+        BETTERLISTINIT_NODISCARD detail::size_t size() const noexcept {return count;}
+        BETTERLISTINIT_NODISCARD bool empty() const noexcept {return count == 0;}
+
+        BETTERLISTINIT_NODISCARD iterator begin() noexcept {return iterator(storage.data());}
+        BETTERLISTINIT_NODISCARD const_iterator begin() const noexcept {return const_iterator(storage.data());}
+        BETTERLISTINIT_NODISCARD iterator end() noexcept {return iterator(storage.data() + count * stride);}
+        BETTERLISTINIT_NODISCARD const_iterator end() const noexcept {return const_iterator(storage.data() + count * stride);}
+
+        BETTERLISTINIT_NODISCARD T &operator[](detail::size_t i) noexcept {return *elem(i);}
+        BETTERLISTINIT_NODISCARD const T &operator[](detail::size_t i) const noexcept {return *elem(i);}
+    };
+
+    namespace custom
+    {
+        // Implicit, same as `fixed_buffer`.
+        template <typename T, detail::size_t Align, typename ...P>
+        struct allow_implicit_range_init<void, padded_buffer<T, Align>, P...> : std::true_type {};
+    }
+    #endif
+
+    #if BETTERLISTINIT_SHARED_ARRAY
+    namespace detail
+    {
+        // Owns the elements of a `std::shared_ptr<T[]>` created from a list. This is what `std::allocate_shared()` constructs,
+        // and the elements are placed right after its control block, see `shared_array_allocator`.
+        template <typename T>
+        struct shared_array_block
+        {
+            T *elems = nullptr;
+            size_t count = 0;
+
+            // `elems_ptr` points to the storage location of the elements, which `shared_array_allocator` writes when allocating this block.
+            // The elements are constructed from `*begin` directly, so they don't need to be movable.
+            template <typename Iter>
+            shared_array_block(T *const *elems_ptr, Iter begin, Iter end)
+                : elems(*elems_ptr)
+            {
+                typename construct_at_functor<T>::guard g(elems);
+                for (size_t n = size_t(end - begin); g.count < n; ++begin)
+                {
+                    ::new((void *)(elems + g.count)) T(*begin);
+                    g.count++;
+                }
+                g.done = true;
+                count = g.count;
+            }
+
+            shared_array_block(const shared_array_block &) = delete;
+            shared_array_block &operator=(const shared_array_block &) = delete;
+
+            ~shared_array_block()
+            {
+                while (count > 0)
+                    elems[--count].~T();
+            }
+        };
+
+        // Wraps the allocator `A`, and makes it allocate room for `n` elements of type `T` after each allocated object,
+        // writing their address to `*elems`. `std::allocate_shared()` uses it (rebound) to allocate its control block, which lets us
+        // have the control block and the elements in the same allocation.
+        template <typename U, typename T, typename A>
+        struct shared_array_allocator
+        {
+            using value_type = U;
+
+            A alloc;
+            size_t n = 0;
+            T **elems = nullptr;
+
+            shared_array_allocator(const A &alloc, size_t n, T **elems) noexcept : alloc(alloc), n(n), elems(elems) {}
+            template <typename V>
+            shared_array_allocator(const shared_array_allocator<V, T, A> &other) noexcept : alloc(other.alloc), n(other.n), elems(other.elems) {}
+
+            // The allocation unit, aligned for both `U` and `T`.
+            struct alignas(U) alignas(T) unit {unsigned char bytes[alignof(U) > alignof(T) ? alignof(U) : alignof(T)];};
+            using unit_traits = typename std::allocator_traits<A>::template rebind_traits<unit>;
+
+            // The offset of the elements in the allocation.
+            static constexpr size_t elems_offset(size_t count) noexcept
+            {
+                return (sizeof(U) * count + alignof(T) - 1) / alignof(T) * alignof(T);
+            }
+            constexpr size_t num_units(size_t count) const noexcept
+            {
+                return (elems_offset(count) + sizeof(T) * n + sizeof(unit) - 1) / sizeof(unit);
+            }
+
+            U *allocate(size_t count)
+            {
+                typename unit_traits::allocator_type unit_alloc(alloc);
+                unit *ptr = &*unit_traits::allocate(unit_alloc, num_units(count));
+                *elems = reinterpret_cast<T *>(reinterpret_cast<unsigned char *>(ptr) + elems_offset(count));
+                return reinterpret_cast<U *>(ptr);
+            }
+            void deallocate(U *ptr, size_t count) noexcept
+            {
+                typename unit_traits::allocator_type unit_alloc(alloc);
+                unit_traits::deallocate(unit_alloc, std::pointer_traits<typename unit_traits::pointer>::pointer_to(*reinterpret_cast<unit *>(ptr)), num_units(count));
+            }
+
+            template <typename V>
+            friend bool operator==(const shared_array_allocator &a, const shared_array_allocator<V, T, A> &b) noexcept
+            {
+                return a.alloc == b.alloc && a.n == b.n && a.elems == b.elems;
+            }
+            template <typename V>
+            friend bool operator!=(const shared_array_allocator &a, const shared_array_allocator<V, T, A> &b) noexcept
+            {
+                return !(a == b);
+            }
+        };
+
+        // Constructs a `std::shared_ptr<T[]>` from a range, using allocator `A` (rebound as needed).
+        // `std::allocate_shared<T[]>()` would value-initialize the elements, so instead we allocate our own `shared_array_block` with it,
+        // and return an aliasing pointer to the elements.
+        template <typename T, typename Iter, typename A>
+        std::shared_ptr<T[]> make_shared_array(Iter begin, Iter end, const A &alloc)
+        {
+            using elem_type = std::remove_cv_t<T>;
+            using block = shared_array_block<elem_type>;
+            elem_type *elems = nullptr;
+            std::shared_ptr<block> ret = std::allocate_shared<block>(shared_array_allocator<block, elem_type, A>(alloc, size_t(end - begin), &elems), &elems, begin, end);
+            return std::shared_ptr<T[]>(ret, ret->elems);
+        }
+    }
+
+    namespace custom
+    {
+        // `std::shared_ptr<T[]>` doesn't have a `value_type`, so it's not a range by default.
+        template <typename T>
+        struct element_type<std::shared_ptr<T[]>> {using type = std::remove_cv_t<T>;};
+
+        // Constructs the control block and the elements in a single allocation. The elements don't need to be movable.
+        template <typename T, typename Iter, typename List>
+        struct construct_range<void, std::shared_ptr<T[]>, Iter, List>
+        {
+            std::shared_ptr<T[]> operator()(Iter begin, Iter end) const
+            {
+                return detail::make_shared_array<T>(static_cast<Iter &&>(begin), static_cast<Iter &&>(end), std::allocator<std::remove_cv_t<T>>{});
+            }
+        };
+        // Same, but with a custom allocator, passed to `.and_with(...)`.
+        template <typename T, typename Iter, typename List, typename A>
+        struct construct_range<void, std::shared_ptr<T[]>, Iter, List, A>
+        {
+            template <typename AA = std::remove_cv_t<std::remove_reference_t<A>>, typename = typename AA::value_type>
+            std::shared_ptr<T[]> operator()(Iter begin, Iter end, A &&alloc) const
+            {
+                return detail::make_shared_array<T>(static_cast<Iter &&>(begin), static_cast<Iter &&>(end), static_cast<const AA &>(alloc));
+            }
+        };
+
+        // Implicit, since a list converts to a `std::shared_ptr<T[]>` only through the `construct_range` specialization above.
+        template <typename T, typename ...P>
+        struct allow_implicit_range_init<void, std::shared_ptr<T[]>, P...> : std::true_type {};
+    }
+    #endif
+
+    #if BETTERLISTINIT_NUMERIC
+    namespace custom
+    {
+        // `std::valarray` has no constructor from two iterators. Its elements are value-initialized, then assigned, in the same allocation.
+        template <typename T, typename Iter, typename List>
+        struct construct_range<void, std::valarray<T>, Iter, List>
+        {
+            std::valarray<T> operator()(Iter begin, Iter end) const
+            {
+                std::valarray<T> ret(detail::size_t(end - begin));
+                for (detail::size_t i = 0; i < ret.size(); i++, ++begin)
+                    ret[i] = T(*begin);
+                return ret;
+            }
+        };
+    }
+
+    #if BETTERLISTINIT_HAVE_SIMD
+    namespace detail
+    {
+        // Whether `std::experimental::simd<T, Abi>` can be loaded from a list of `P...`: there must be exactly one arithmetic element per lane.
+        template <typename T, typename Abi, typename ...P>
+        struct simd_loadable : std::integral_constant<bool,
+            sizeof...(P) == std::experimental::simd_size_v<T, Abi> &&
+            all_of<std::is_arithmetic<std::remove_reference_t<P>>..., std::is_convertible<P, T>...>::value
+        > {};
+
+        // Loads a `std::experimental::simd<T, Abi>` from a list of `P...`, see `simd_loadable`.
+        // The elements are gathered into an aligned array on the stack, and then loaded with a single vector load.
+        template <typename T, typename Abi, typename ...P>
+        struct construct_simd
+        {
+            std::experimental::simd<T, Abi> operator()(P &&... params) const
+            {
+                using simd_t = std::experimental::simd<T, Abi>;
+                alignas(std::experimental::memory_alignment_v<simd_t>) const T lanes[] = {T(static_cast<P &&>(params))...};
+                return simd_t(lanes, std::experimental::vector_aligned);
+            }
+        };
+    }
+
+    namespace custom
+    {
+        // `std::experimental::simd` has a `value_type`, but no iterators, so we construct it as a non-range.
+        template <typename T, typename Abi>
+        struct is_range<std::experimental::simd<T, Abi>> : std::false_type {};
+
+        // A list with an element per lane is loaded into the lanes. Otherwise, use the usual braced initialization (e.g. a single value is broadcasted).
+        template <typename T, typename Abi, typename List, typename ...P>
+        struct construct_nonrange<void, std::experimental::simd<T, Abi>, List, P...>
+            : std::conditional_t<detail::simd_loadable<T, Abi, P...>::value,
+                detail::construct_simd<T, Abi, P...>,
+                detail::default_construct_nonrange<void, std::experimental::simd<T, Abi>, List, P...>
+            >
+        {};
+
+        // Loading the lanes is fine to do implicitly.
+        template <typename T, typename Abi, typename ...P>
+        struct allow_implicit_nonrange_init<void, std::experimental::simd<T, Abi>, P...>
+            : detail::any_of<detail::simd_loadable<T, Abi, P...>, detail::implicitly_brace_constructible<std::experimental::simd<T, Abi>, P...>>
+        {};
+    }
+    #endif
+    #endif
+
+    #if BETTERLISTINIT_COROUTINES
+    // An executor that runs the jobs immediately, on the current thread.
+    // Awaiting a list with it starts each awaitable in order, and moves on to the next one when the previous one suspends.
+    // Executors are passed to `init{...}.when_all(executor)`. They must have `.post(std::coroutine_handle<> job)`, which must eventually call `job.resume()`, on any thread.
+    struct inline_executor
+    {
+        void post(std::coroutine_handle<> job) const
+        {
+            job.resume();
+        }
+    };
+
+    namespace detail
+    {
+        // The awaiter used by `co_await` on a `T` (a forwarding reference), possibly returned by its `operator co_await`. `get()` returns it.
+        template <typename T, typename = void>
+        struct awaiter_type
+        {
+            using type = T &&;
+            static type get(T &&awaitable) noexcept {return static_cast<T &&>(awaitable);}
+        };
+        template <typename T>
+        struct awaiter_type<T, decltype(void(operator co_await(declval<T>())))>
+        {
+            using type = decltype(operator co_await(declval<T>()));
+            static type get(T &&awaitable) {return operator co_await(static_cast<T &&>(awaitable));}
+        };
+        template <typename T>
+        struct awaiter_type<T, decltype(void(declval<T>().operator co_await()))>
+        {
+            using type = decltype(declval<T>().operator co_await());
+            static type get(T &&awaitable) {return static_cast<T &&>(awaitable).operator co_await();}
+        };
+
+        // Forwards to the awaiter of a `T`, see `awaiter_type`, except that `co_await` on it returns nothing, and `.result()` returns the actual result.
+        // This lets us construct the result in place, with a placement-new outside of the `co_await` expression.
+        // (GCC 12 crashes on `co_await` in a new-expression, and tries to copy the non-prvalue operands of `co_await`.)
+        template <typename T>
+        struct awaiter_ref
+        {
+            typename awaiter_type<T>::type awaiter;
+
+            bool await_ready() {return awaiter.await_ready();}
+            template <typename H>
+            decltype(auto) await_suspend(H handle) {return awaiter.await_suspend(handle);}
+            void await_resume() noexcept {}
+
+            decltype(auto) result() {return static_cast<typename awaiter_type<T>::type &&>(awaiter).await_resume();}
+        };
+
+        // The result of `co_await` on a `T` (a forwarding reference), with the reference and cv-qualifiers removed. Not defined if `T` is not awaitable.
+        template <typename T, typename = void>
+        struct await_result {};
+        template <typename T>
+        struct await_result<T, std::enable_if_t<!std::is_void<decltype(declval<typename awaiter_type<T>::type &>().await_resume())>::value>>
+        {
+            using type = std::remove_cv_t<std::remove_reference_t<decltype(declval<typename awaiter_type<T>::type &>().await_resume())>>;
+        };
+
+        template <typename T, typename = void>
+        struct can_gather_elem : std::false_type {};
+        template <typename T>
+        struct can_gather_elem<T, decltype(void(declval<typename await_result<T>::type>()))> : std::integral_constant<bool,
+            !std::is_array<typename await_result<T>::type>::value && std::is_move_constructible<typename await_result<T>::type>::value
+        > {};
+
+        // The state shared by the jobs of `gather_awaitable`.
+        struct gather_state
+        {
+            // The number of jobs that haven't finished yet, plus one until all of them are posted.
+            std::atomic<size_t> remaining{0};
+            // The coroutine awaiting the results.
+            std::coroutine_handle<> awaiting;
+            // The first exception thrown by the jobs, if any.
+            std::atomic<bool> failed{false};
+            std::exception_ptr exception;
+
+            void set_exception(std::exception_ptr e) noexcept
+            {
+                if (!failed.exchange(true, std::memory_order_relaxed))
+                    exception = static_cast<std::exception_ptr &&>(e);
+            }
+
+            // Called when a job finishes, or when all jobs are posted. Returns the coroutine to resume next.
+            // The last one to finish resumes the awaiting coroutine. The `acq_rel` makes the results visible to it.
+            std::coroutine_handle<> finish() noexcept
+            {
+                if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    return awaiting;
+                return std::noop_coroutine();
+            }
+        };
+
+        // A coroutine that awaits a single element of `gather_awaitable`.
+        // It starts suspended, is resumed by the executor, and destroys itself when done.
+        struct gather_job
+        {
+            struct promise_type
+            {
+                gather_state *state = nullptr;
+
+                template <typename ...A>
+                promise_type(gather_state &state, A &...) noexcept : state(&state) {}
+
+                gather_job get_return_object() noexcept {return {std::coroutine_handle<promise_type>::from_promise(*this)};}
+                std::suspend_always initial_suspend() noexcept {return {};}
+                void return_void() noexcept {}
+                void unhandled_exception() noexcept {state->set_exception(std::current_exception());}
+
+                struct final_awaiter
+                {
+                    bool await_ready() noexcept {return false;}
+                    std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> job) noexcept
+                    {
+                        gather_state *state = job.promise().state;
+                        job.destroy();
+                        return state->finish();
+                    }
+                    void await_resume() noexcept {}
+                };
+                final_awaiter final_suspend() noexcept {return {};}
+            };
+
+            std::coroutine_handle<promise_type> handle;
+        };
+
+        // Stores an element of `gather_awaitable`, and the storage for its result.
+        template <size_t I, typename P>
+        struct gather_leaf
+        {
+            using result_type = typename await_result<P>::type;
+
+            std::remove_reference_t<P> *awaitable = nullptr;
+            alignas(result_type) unsigned char storage[sizeof(result_type)];
+            bool constructed = false;
+
+            gather_leaf(std::remove_reference_t<P> *awaitable) noexcept : awaitable(awaitable) {}
+
+            result_type *result() noexcept {return std::launder(reinterpret_cast<result_type *>(storage));}
+
+            void destroy() noexcept
+            {
+                if (constructed)
+                    result()->~result_type();
+            }
+        };
+
+        // Awaits the list elements `P...` (forwarding references to awaitables) concurrently, starting each one as a job on `Executor`.
+        // Each result is constructed directly in the storage of this object, as soon as it's ready. `co_await` returns an `init{...}` list
+        // of rvalue references to the results, which converts to a container, a tuple, etc.
+        // If any of the elements throw, the first exception is rethrown, after all of them finish.
+        template <typename Executor, typename Seq, typename ...P>
+        class gather_awaitable_impl;
+        template <typename Executor, size_t ...I, typename ...P>
+        class gather_awaitable_impl<Executor, index_sequence<I...>, P...> : gather_leaf<I, P>...
+        {
+            Executor executor;
+            gather_state state;
+
+            template <size_t J, typename Q>
+            static gather_job run(gather_state &, gather_leaf<J, Q> &leaf)
+            {
+                awaiter_ref<Q> awaiter{awaiter_type<Q>::get(static_cast<Q &&>(*leaf.awaitable))};
+                co_await awaiter;
+                ::new((void *)leaf.storage) typename gather_leaf<J, Q>::result_type(awaiter.result());
+                leaf.constructed = true;
+            }
+
+            // If the executor throws, the job counts as finished, and the exception is rethrown from `await_resume()`.
+            // We can't throw it from `await_suspend()`, because the jobs posted before it are already running, and refer to this object.
+            void post(std::coroutine_handle<> job) noexcept
+            {
+                try
+                {
+                    executor.post(job);
+                }
+                catch (...)
+                {
+                    job.destroy();
+                    state.set_exception(std::current_exception());
+                    (void)state.finish(); // Can't be the last one, because of the extra count.
+                }
+            }
+
+          public:
+            template <typename E>
+            gather_awaitable_impl(E &&executor, P &&... params) noexcept
+                : gather_leaf<I, P>(&params)..., executor(static_cast<E &&>(executor))
+            {}
+
+            // Because the jobs refer to this object.
+            gather_awaitable_impl(const gather_awaitable_impl &) = delete;
+            gather_awaitable_impl &operator=(const gather_awaitable_impl &) = delete;
+
+            ~gather_awaitable_impl()
+            {
+                (void(static_cast<gather_leaf<I, P> &>(*this).destroy()), ...);
+            }
+
+            bool await_ready() const noexcept
+            {
+                return sizeof...(P) == 0;
+            }
+
+            bool await_suspend(std::coroutine_handle<> awaiting)
+            {
+                state.awaiting = awaiting;
+                state.remaining.store(sizeof...(P) + 1, std::memory_order_relaxed);
+
+                // Create all jobs before posting them, so that if an allocation fails, we can just destroy them.
+                gather_job jobs[] = {gather_job{}, (void(I), gather_job{})...};
+                try
+                {
+                    ((jobs[I + 1] = run(state, static_cast<gather_leaf<I, P> &>(*this))), ...);
+                }
+                catch (...)
+                {
+                    for (gather_job &job : jobs)
+                    {
+                        if (job.handle)
+                            job.handle.destroy();
+                    }
+                    throw;
+                }
+
+                (post(jobs[I + 1].handle), ...);
+
+                // Keep suspended, unless all jobs have already finished.
+                return state.finish() != awaiting;
+            }
+
+            type::BETTERLISTINIT_IDENTIFIER<typename gather_leaf<I, P>::result_type...> await_resume()
+            {
+                if (state.exception)
+                    std::rethrow_exception(state.exception);
+                return {static_cast<typename gather_leaf<I, P>::result_type &&>(*static_cast<gather_leaf<I, P> &>(*this).result())...};
+            }
+        };
+
+        template <typename Executor, typename ...P>
+        using gather_awaitable = gather_awaitable_impl<Executor, make_index_sequence<sizeof...(P)>, P...>;
+
+        // Constructs a `gather_awaitable` from the elements of a list.
+        template <typename Executor>
+        struct gather_functor
+        {
+            Executor &&executor;
+
+            template <typename ...P>
+            gather_awaitable<Executor, P...> operator()(P &&... params) const noexcept
+            {
+                return {static_cast<Executor &&>(executor), static_cast<P &&>(params)...};
+            }
+        };
+    }
+    #endif
+
+    #if BETTERLISTINIT_BOXED
+    namespace detail
+    {
+        // Destroys a `T` at `ptr`.
+        template <typename T>
+        void destroy_object(void *ptr) noexcept
+        {
+            static_cast<T *>(ptr)->~T();
+        }
+
+        // The layout of the memory block of a `poly_buffer<Base>`, holding objects of types `D...`: first the `Base *` handles, then the objects.
+        // This is computed at compile-time, and the buffer points to it, so it doesn't have to store the offsets and the destructors for each object.
+        template <typename Base, typename ...D>
+        struct boxed_layout
+        {
+            // The object offsets from the beginning of the block. The `+ 1` is here to support empty lists.
+            size_t offsets[sizeof...(D) + 1]{};
+            void (*destroy[sizeof...(D) + 1])(void *) = {&destroy_object<D>..., nullptr};
+            // The size and alignment of the whole block.
+            size_t size = sizeof(Base *) * sizeof...(D);
+            size_t align = alignof(Base *);
+
+            constexpr boxed_layout()
+            {
+                constexpr size_t sizes[] = {sizeof(D)..., 0};
+                constexpr size_t aligns[] = {alignof(D)..., 1};
+                for (size_t i = 0; i < sizeof...(D); i++)
+                {
+                    if (aligns[i] > align)
+                        align = aligns[i];
+                    size = (size + aligns[i] - 1) / aligns[i] * aligns[i];
+                    offsets[i] = size;
+                    size += sizes[i];
+                }
+            }
+        };
+        template <typename Base, typename ...D>
+        constexpr boxed_layout<Base, D...> boxed_layout_v{};
+
+        // Passed to the `poly_buffer` constructor, see `init{...}.boxed<Base>()`.
+        struct boxed_tag {};
+    }
+
+    // A fixed-size array of polymorphic objects derived from `Base`, stored in a single memory block, see `init{...}.boxed<Base>()`.
+    // Behaves like `std::vector<std::unique_ptr<Base>>` that can't be resized: the elements are `Base *` handles to the owned objects.
+    // Unlike `std::unique_ptr<Base>`, `Base` doesn't need a virtual destructor, since the buffer remembers the actual object types.
+    template <typename Base>
+    class poly_buffer
+    {
+        // The block starts with the handles, followed by the objects.
+        detail::raw_storage storage;
+        detail::size_t count = 0;
+        // Point to the `detail::boxed_layout` of the objects.
+        const detail::size_t *offsets = nullptr;
+        void (*const *destroyers)(void *) = nullptr;
+
+        Base **handles() const noexcept {return reinterpret_cast<Base **>(storage.data());}
+
+        // Destroys the first `count` objects. The memory is freed by `storage`.
+        void destroy() noexcept
+        {
+            for (detail::size_t i = count; i-- > 0;)
+                destroyers[i](storage.data() + offsets[i]);
+        }
+
+        template <typename D, typename P>
+        static void construct_object(unsigned char *block, Base **handles, detail::size_t i, detail::size_t offset, P &&param)
+        {
+            D *object = ::new((void *)(block + offset)) D(static_cast<P &&>(param));
+            handles[i] = object;
+        }
+
+        // Constructs objects of types `D...` from `params...`, see the public constructor below.
+        template <typename ...D, typename ...P>
+        poly_buffer(const detail::boxed_layout<Base, D...> &layout, P &&... params)
+            : storage(layout.size, layout.align), offsets(layout.offsets), destroyers(layout.destroy)
+        {
+            try
+            {
+                // The braced list guarantees the left-to-right order.
+                const int dummy[] = {(construct_object<D>(storage.data(), handles(), count, offsets[count], static_cast<P &&>(params)), count++, 0)..., 0};
+                (void)dummy;
+            }
+            catch (...)
+            {
+                destroy();
+                throw;
+            }
+        }
+
+      public:
+        using value_type = Base *;
+        using size_type = detail::size_t;
+        using difference_type = detail::ptrdiff_t;
+        using reference = Base *const &;
+        using const_reference = Base *const &;
+        using iterator = Base *const *;
+        using const_iterator = Base *const *;
+
+        constexpr poly_buffer() noexcept {}
+
+        // Constructs objects of types `std::remove_cv_t<std::remove_reference_t<P>>...` from `params...`. Prefer `init{...}.boxed<Base>()` to calling this directly.
+        // If any constructor throws, the already constructed objects are destroyed.
+        template <typename ...P>
+        poly_buffer(detail::boxed_tag, P &&... params)
+            : poly_buffer(detail::boxed_layout_v<Base, std::remove_cv_t<std::remove_reference_t<P>>...>, static_cast<P &&>(params)...)
+        {
+            static_assert(detail::all_of_flat<std::is_base_of<Base, std::remove_cv_t<std::remove_reference_t<P>>>...>::value, "All elements must be derived from `Base`, or be `Base` itself.");
+        }
+
+        poly_buffer(poly_buffer &&other) noexcept
+            : storage(static_cast<detail::raw_storage &&>(other.storage)), count(other.count), offsets(other.offsets), destroyers(other.destroyers)
+        {
+            other.count = 0;
+        }
+        poly_buffer &operator=(poly_buffer &&other) noexcept
+        {
+            if (this != &other)
+            {
+                destroy();
+                storage = static_cast<detail::raw_storage &&>(other.storage);
+                count = other.count;
+                offsets = other.offsets;
+                destroyers = other.destroyers;
+                other.count = 0;
+            }
+            return *this;
+        }
+
+        ~poly_buffer()
+        {
+            destroy();
+        }
+
+        BETTERLISTINIT_NODISCARD detail::size_t size() const noexcept {return count;}
+        BETTERLISTINIT_NODISCARD bool empty() const noexcept {return count == 0;}
+
+        BETTERLISTINIT_NODISCARD Base *const *begin() const noexcept {return handles();}
+        BETTERLISTINIT_NODISCARD Base *const *end() const noexcept {return handles() + count;}
+
+        BETTERLISTINIT_NODISCARD Base *operator[](detail::size_t i) const noexcept {return handles()[i];}
+    };
+
+    namespace detail
+    {
+        // Constructs a `poly_buffer<Base>` from the elements.
+        template <typename Base>
+        struct boxed_functor
+        {
+            template <typename ...P>
+            poly_buffer<Base> operator()(P &&... params) const
+            {
+                return poly_buffer<Base>(boxed_tag{}, static_cast<P &&>(params)...);
+            }
+        };
+    }
+    #endif
+
+    namespace detail
+    {
+        // The reference type that the elements `P...` are normalized to for ranges of `T`s, see `custom::normalized_elem`.
+        template <typename T, typename ...P>
+        struct normalized_elem_ref {using type = void;};
+        template <typename T, typename P0, typename ...P>
+        struct normalized_elem_ref<T, P0, P...>
+        {
+            using elem_type = typename custom::normalized_elem<T, P0 &&>::type;
+            using type = std::conditional_t<std::is_reference<elem_type>::value, elem_type, elem_type &&>;
+            // Whether the elements must be converted to `elem_type` first, rather than bound to `type` directly.
+            static constexpr bool materialize = !std::is_reference<elem_type>::value;
+        };
+
+        // Whether a list of `P...` is heterogeneous, but all its elements normalize to the same type for range elements `T`. See `custom::normalized_elem`.
+        template <typename T, typename ...P>
+        struct uses_normalized_elems : std::integral_constant<bool,
+            (sizeof...(P) > 1) && !all_types_same<P...>::value && all_of_flat<is_single_elem<P>...>::value &&
+            all_types_same<typename custom::normalized_elem<T, P &&>::type...>::value
+        > {};
+        // Same, but `T` is the range type.
+        template <typename Void, typename T, typename ...P>
+        struct range_uses_normalized_elems_helper : std::false_type {};
+        template <typename T, typename ...P>
+        struct range_uses_normalized_elems_helper<std::enable_if_t<custom::is_range<T>::value>, T, P...> : uses_normalized_elems<typename custom::element_type<T>::type, P...> {};
+        template <typename T, typename ...P>
+        struct range_uses_normalized_elems : range_uses_normalized_elems_helper<void, T, P...> {};
+
+        // Points `ptrs[i]` to the `i`th element.
+        template <typename T>
+        struct elem_ptrs_functor
+        {
+            T **ptrs;
+
+            template <typename ...P>
+            constexpr void operator()(P &&... elems) const noexcept
+            {
+                T **ptr = ptrs;
+                int dummy[] = {0, (void(*ptr++ = &elems), 0)...};
+                (void)dummy;
+            }
+        };
+
+        // Converts the `i`th element to `values[i]`, and points `ptrs[i]` to it.
+        template <typename T>
+        struct elem_values_functor
+        {
+            T *values;
+            T **ptrs;
+
+            template <typename ...P>
+            constexpr void operator()(P &&... elems) const
+            {
+                T *value = values;
+                int dummy[] = {0, (void(*value++ = T(static_cast<P &&>(elems))), 0)...};
+                (void)dummy;
+                for (size_t i = 0; i < sizeof...(P); i++)
+                    ptrs[i] = values + i;
+            }
+        };
+
+        // Performance lint checks, see `BETTERLISTINIT_LINT`. Each is true if converting a list of `P...` to `T` is likely more expensive than it needs to be.
+
+        // All elements are scalars. They don't benefit from being moved, so a plain braced list is as fast, and compiles faster.
+        template <typename T, typename ...P>
+        struct lint_all_scalars : std::integral_constant<bool, sizeof...(P) != 0 && all_of_flat<std::is_scalar<std::remove_reference_t<P>>...>::value> {};
+
+        // A range is initialized from a heterogeneous list, whose elements only differ in value category and constness, or are integers of different types.
+        // Heterogeneous lists construct the elements through function pointers, and instantiate more code. Cast the elements to the same type to avoid this.
+        // Unless the elements normalize to the same type (see `custom::normalized_elem`), then the list is converted as if it was homogeneous.
+        template <typename T, typename ...P>
+        struct lint_needlessly_heterogeneous : std::integral_constant<bool,
+            custom::is_range<T>::value && (sizeof...(P) > 1) && !all_types_same<P...>::value && all_of_flat<is_single_elem<P>...>::value && !range_uses_normalized_elems<T, P...>::value &&
+            (all_types_same<std::remove_cv_t<std::remove_reference_t<P>>...>::value || all_of_flat<std::is_integral<std::remove_reference_t<P>>...>::value)
+        > {};
+
+        template <typename T>
+        struct has_nontrivial_elements : negate<std::is_trivially_copyable<typename custom::element_type<T>::type>> {};
+
+        // Before C++17, heterogeneous lists construct each element of a range as a temporary, and then move it into place.
+        // This only matters for non-trivially-copyable elements.
+        template <typename T, typename ...P>
+        struct lint_element_temporaries : std::integral_constant<bool,
+            BETTERLISTINIT_CXX_STANDARD < 17 && sizeof...(P) != 0 && !(all_types_same<P...>::value && all_of_flat<is_single_elem<P>...>::value) &&
+            all_of<custom::is_range<T>, has_nontrivial_elements<T>>::value
+        > {};
+
+        // The list is longer than `BETTERLISTINIT_LINT_MAX_SIZE`.
+        template <typename T, typename ...P>
+        struct lint_too_long : std::integral_constant<bool, (sizeof...(P) > BETTERLISTINIT_LINT_MAX_SIZE)> {};
+
+        // The diagnostics for the checks above, one per check, so that the diagnostic says which check fired.
+        // `Fired` is the value of the check. If it's true, calling `check()` causes a deprecation warning, or a hard error if `BETTERLISTINIT_LINT >= 2`.
+        // `T` is the target type, and `P...` are the list elements, so they appear in the diagnostic too.
+        struct lint_passed
+        {
+            BETTERLISTINIT_FORCEINLINE static constexpr void check() {}
+        };
+
+        // See `lint_all_scalars`.
+        template <bool Fired, typename T, typename ...P>
+        struct all_scalar_list_use_plain_braces : lint_passed {};
+        template <typename T, typename ...P>
+        struct all_scalar_list_use_plain_braces<true, T, P...>
+        {
+            #if BETTERLISTINIT_LINT >= 2
+            static_assert(dependent_value<T, false>::value, "better_list_init performance lint: all elements are scalars, a plain braced list does the same and compiles faster.");
+            BETTERLISTINIT_FORCEINLINE static constexpr void check() {}
+            #else
+            [[deprecated("better_list_init performance lint: all elements are scalars, a plain braced list does the same and compiles faster.")]]
+            BETTERLISTINIT_FORCEINLINE static constexpr void check() {}
+            #endif
+        };
+
+        // See `lint_needlessly_heterogeneous`.
+        template <bool Fired, typename T, typename ...P>
+        struct heterogeneous_list_cast_elements_to_same_type : lint_passed {};
+        template <typename T, typename ...P>
+        struct heterogeneous_list_cast_elements_to_same_type<true, T, P...>
+        {
+            #if BETTERLISTINIT_LINT >= 2
+            static_assert(dependent_value<T, false>::value, "better_list_init performance lint: the elements only differ in value category and constness, or are integers of different types. Cast them to the same type to make the list homogeneous.");
+            BETTERLISTINIT_FORCEINLINE static constexpr void check() {}
+            #else
+            [[deprecated("better_list_init performance lint: the elements only differ in value category and constness, or are integers of different types. Cast them to the same type to make the list homogeneous.")]]
+            BETTERLISTINIT_FORCEINLINE static constexpr void check() {}
+            #endif
+        };
+
+        // See `lint_element_temporaries`.
+        template <bool Fired, typename T, typename ...P>
+        struct pre_cxx17_list_constructs_element_temporaries : lint_passed {};
+        template <typename T, typename ...P>
+        struct pre_cxx17_list_constructs_element_temporaries<true, T, P...>
+        {
+            #if BETTERLISTINIT_LINT >= 2
+            static_assert(dependent_value<T, false>::value, "better_list_init performance lint: before C++17, heterogeneous lists construct each element as a temporary, then move it into place.");
+            BETTERLISTINIT_FORCEINLINE static constexpr void check() {}
+            #else
+            [[deprecated("better_list_init performance lint: before C++17, heterogeneous lists construct each element as a temporary, then move it into place.")]]
+            BETTERLISTINIT_FORCEINLINE static constexpr void check() {}
+            #endif
+        };
+
+        // See `lint_too_long`.
+        template <bool Fired, typename T, typename ...P>
+        struct list_longer_than_lint_max_size : lint_passed {};
+        template <typename T, typename ...P>
+        struct list_longer_than_lint_max_size<true, T, P...>
+        {
+            #if BETTERLISTINIT_LINT >= 2
+            static_assert(dependent_value<T, false>::value, "better_list_init performance lint: the list has more elements than `BETTERLISTINIT_LINT_MAX_SIZE`, each one adds to the compilation time.");
+            BETTERLISTINIT_FORCEINLINE static constexpr void check() {}
+            #else
+            [[deprecated("better_list_init performance lint: the list has more elements than `BETTERLISTINIT_LINT_MAX_SIZE`, each one adds to the compilation time.")]]
+            BETTERLISTINIT_FORCEINLINE static constexpr void check() {}
+            #endif
+        };
+
+        // Runs the lint checks for converting a list of `P...` to `T`, if `BETTERLISTINIT_LINT` is enabled.
+        template <typename T, typename ...P>
+        BETTERLISTINIT_FORCEINLINE constexpr void lint()
+        {
+            #if BETTERLISTINIT_LINT
+            all_scalar_list_use_plain_braces<lint_all_scalars<T, P...>::value, T, P...>::check();
+            heterogeneous_list_cast_elements_to_same_type<lint_needlessly_heterogeneous<T, P...>::value, T, P...>::check();
+            pre_cxx17_list_constructs_element_temporaries<lint_element_temporaries<T, P...>::value, T, P...>::check();
+            list_longer_than_lint_max_size<lint_too_long<T, P...>::value, T, P...>::check();
+            #endif
+        }
+    }
+
+    // `better_list_init::type::init` is the type of our list class.
+    // I don't want to put it into `detail`, because it can be renamed by the user, and I don't want naming conflicts.
+    namespace type
     {
         template <typename ...P>
         class BETTERLISTINIT_NODISCARD BETTERLISTINIT_IDENTIFIER
-            : detail::maybe_copyable<detail::all_of<std::is_lvalue_reference<P>...>::value>
+            : detail::maybe_copyable<detail::all_of_flat<std::is_lvalue_reference<P>...>::value>
         {
           public:
             // Whether this list can be used to initialize a range of `T`s.
-            template <typename T> struct can_initialize_elem         : detail::all_of<detail::constructible        <T, P>...> {};
-            template <typename T> struct can_nothrow_initialize_elem : detail::all_of<detail::nothrow_constructible<T, P>...> {};
+            template <typename T> struct can_initialize_elem         : detail::all_of_flat<detail::constructible        <T, typename detail::elem_traits<P>::elem_type>...> {};
+            template <typename T> struct can_nothrow_initialize_elem : detail::all_of_flat<detail::nothrow_constructible<T, typename detail::elem_traits<P>::elem_type>...> {};
+
+            // Whether some of the elements don't expand to exactly one element, i.e. `when(cond, expr)` or `spread(range)`. Such lists can only initialize ranges.
+            static constexpr bool has_variable_size_elems = !detail::all_of_flat<detail::is_single_elem<P>...>::value;
+            // Whether some of the elements expand to a runtime number of elements: spliced ranges created with `spread(range)`, or `generate(n, func)` and `repeat(n, value)`.
+            static constexpr bool has_spread_elems = detail::any_of_flat<detail::is_spread_elem<P>...>::value;
+
+            // Whether all types in `P...` are the same (and there is at least one type, and all of them expand to exactly one element). Then we can simplify some logic.
+            // static constexpr bool is_homogeneous = detail::all_types_same<P...>::value && sizeof...(P) > 0;
+            static constexpr bool is_homogeneous = detail::all_types_same<P...>::value && sizeof...(P) > 0 && !has_variable_size_elems;
+            // If all types in `P...` are the same (and there's at least one), returns that type. Otherwise returns an empty struct.
+            using homogeneous_type = typename std::conditional_t<is_homogeneous, detail::first_type<P &&...>, std::enable_if<true, detail::empty>>::type;
+
+            // Whether all our references are lvalue references. Such lists can be copied.
+            static constexpr bool is_lvalue_only = detail::all_of_flat<std::is_lvalue_reference<P>...>::value;
+
+            // Whether all elements are const arrays of the same character type, normally string literals (and there's at least one element).
+            static constexpr bool is_char_array_list = sizeof...(P) > 0 && detail::all_of_flat<detail::char_array_traits<P>...>::value &&
+                detail::all_types_same<typename detail::char_array_traits<P>::char_type...>::value;
+            // If `is_char_array_list` is true, the character type. Otherwise `void`.
+            using char_array_type = std::conditional_t<is_char_array_list, typename detail::first_type<typename detail::char_array_traits<P>::char_type..., void>::type, void>;
+
+            // Whether ranges of `T`s are initialized from `detail::char_array_ref`s, which carry the array lengths, instead of from the elements directly.
+            template <typename T>
+            struct uses_char_array_refs : detail::all_of<std::integral_constant<bool, is_char_array_list>, detail::char_array_constructible<T, char_array_type>> {};
+
+            // Whether ranges of `T`s are initialized as if the list was homogeneous, after normalizing the elements. See `custom::normalized_elem`.
+            template <typename T>
+            struct uses_normalized_elems : detail::all_of<detail::negate<uses_char_array_refs<T>>, detail::uses_normalized_elems<T, P...>> {};
+
+          private:
+            using tuple_t = detail::tuple<P &&...>;
+
+            // Whether this list can be used to initialize a range of `T`s, after applying a transformation `Tr` to the elements.
+            template <typename T, typename Tr> struct can_initialize_transformed_elem         : detail::all_of_flat<detail::transform_constructible        <T, Tr, typename detail::elem_traits<P>::elem_type>...> {};
+            template <typename T, typename Tr> struct can_nothrow_initialize_transformed_elem : detail::all_of_flat<detail::nothrow_transform_constructible<T, Tr, typename detail::elem_traits<P>::elem_type>...> {};
+
+            // Lists with spliced ranges (see `spread(range)`) and transformed lists (see `.transform(f)`) use this as the element type for the iterators.
+            // Since the size is only known at runtime, we can't preallocate those like `elem_ref`s, so the iterators return them by value.
+            // `Tr` is the transformation applied to the elements, see `detail::no_transform`.
+            template <typename T, typename Tr = detail::no_transform>
+            class proxy_iter;
+
+            template <typename T, typename Tr = detail::no_transform>
+            class proxy_ref : detail::elem_ref_base
+            {
+                friend BETTERLISTINIT_IDENTIFIER;
+                friend proxy_iter<T, Tr>;
+                const tuple_t *target = nullptr;
+                const Tr *transform = nullptr;
+                detail::size_t index = 0;
+                // The index in the expanded element.
+                detail::size_t offset = 0;
+                // The index in the target range.
+                detail::size_t pos = 0;
+
+                BETTERLISTINIT_FORCEINLINE constexpr proxy_ref() {}
+                // Only the iterator can copy these (to return them by value, which pre-C++17 needs a copy constructor).
+                // Otherwise constructors accepting any type (such as `std::any`'s) would store the reference itself, rather than a `T`, and it would dangle.
+                BETTERLISTINIT_FORCEINLINE constexpr proxy_ref(const proxy_ref &) = default;
+
+                #if BETTERLISTINIT_TRACE
+                BETTERLISTINIT_FORCEINLINE BETTERLISTINIT_CONSTEXPR_TRACE void trace() const noexcept
+                {
+                    constexpr trace_element_kind kinds[] = {detail::trace_kind<T, typename detail::elem_traits<P>::elem_type, !std::is_same<Tr, detail::no_transform>::value>::value..., trace_element_kind::move};
+                    detail::trace_element<T>(pos, kinds[index]);
+                }
+                #endif
+
+              public:
+                proxy_ref &operator=(const proxy_ref &) = delete;
+
+                BETTERLISTINIT_FORCEINLINE constexpr operator T() const noexcept(can_nothrow_initialize_transformed_elem<T, Tr>::value)
+                {
+                    #if BETTERLISTINIT_TRACE
+                    trace();
+                    #endif
+                    return target->template apply_to_elem<detail::construct_from_elem<T, Tr>>(index, offset, *transform, pos);
+                }
+
+                #if BETTERLISTINIT_ALLOCATOR_HACK
+                // Constructs an object at the specified address, using an allocator.
+                template <typename Alloc>
+                BETTERLISTINIT_FORCEINLINE constexpr void _allocator_hack_construct_at(Alloc &alloc, T *location) const noexcept(can_nothrow_initialize_transformed_elem<T, Tr>::value)
+                {
+                    #if BETTERLISTINIT_TRACE
+                    trace();
+                    #endif
+                    target->template apply_to_elem<detail::allocator_hack::construct_from_elem_at<T, Alloc, Tr>>(index, alloc, location, offset, *transform, pos);
+                }
+                #endif
+            };
+
+            // The iterator class for lists with spliced ranges and transformed lists.
+            // It still reports itself as random-access (and is one, except for `*` returning by value), so that the containers compute the size and allocate once.
+            template <typename T, typename Tr>
+            class proxy_iter
+            {
+                friend BETTERLISTINIT_IDENTIFIER;
+                const tuple_t *target = nullptr;
+                const Tr *transform = nullptr;
+                // `ends[i]` is the position past the `i`th element in the expanded list.
+                const detail::size_t *ends = nullptr;
+                // The position in the expanded list.
+                detail::size_t pos = 0;
+                // The element containing `pos`, or `sizeof...(P)` if we're at the end.
+                detail::size_t index = 0;
+
+                // Recomputes `index` from `pos`, using a binary search.
+                constexpr void find_index() noexcept
+                {
+                    detail::size_t first = 0, count = sizeof...(P);
+                    while (count > 0)
+                    {
+                        detail::size_t step = count / 2;
+                        if (ends[first + step] <= pos)
+                        {
+                            first += step + 1;
+                            count -= step + 1;
+                        }
+                        else
+                        {
+                            count = step;
+                        }
+                    }
+                    index = first;
+                }
+
+              public:
+                using iterator_category = std::random_access_iterator_tag;
+                using iterator_concept = std::random_access_iterator_tag;
+                using reference = proxy_ref<T, Tr>;
+                using value_type = proxy_ref<T, Tr>;
+                using pointer = void;
+                using difference_type = detail::ptrdiff_t;
+
+                BETTERLISTINIT_FORCEINLINE constexpr proxy_iter() noexcept {}
+
+                BETTERLISTINIT_FORCEINLINE constexpr reference operator*() const noexcept
+                {
+                    // Dereferencing the end iterator is UB anyway. This check stops GCC from warning about out-of-bounds accesses in `apply_to_elem()`.
+                    if (index >= sizeof...(P))
+                        detail::abort();
+
+                    proxy_ref<T, Tr> ret;
+                    ret.target = target;
+                    ret.transform = transform;
+                    ret.index = index;
+                    ret.offset = pos - (index == 0 ? 0 : ends[index - 1]);
+                    ret.pos = pos;
+                    return ret;
+                }
+
+                friend BETTERLISTINIT_FORCEINLINE constexpr bool operator==(proxy_iter a, proxy_iter b) noexcept {return a.pos == b.pos;}
+                friend BETTERLISTINIT_FORCEINLINE constexpr bool operator!=(proxy_iter a, proxy_iter b) noexcept {return a.pos != b.pos;}
+                friend BETTERLISTINIT_FORCEINLINE constexpr bool operator< (proxy_iter a, proxy_iter b) noexcept {return a.pos < b.pos;}
+                friend BETTERLISTINIT_FORCEINLINE constexpr bool operator> (proxy_iter a, proxy_iter b) noexcept {return b < a;}
+                friend BETTERLISTINIT_FORCEINLINE constexpr bool operator<=(proxy_iter a, proxy_iter b) noexcept {return !(b < a);}
+                friend BETTERLISTINIT_FORCEINLINE constexpr bool operator>=(proxy_iter a, proxy_iter b) noexcept {return !(a < b);}
+
+                // Stepping skips empty elements, which is amortized O(1).
+                BETTERLISTINIT_FORCEINLINE constexpr proxy_iter &operator++() noexcept
+                {
+                    ++pos;
+                    while (index < sizeof...(P) && ends[index] <= pos)
+                        ++index;
+                    return *this;
+                }
+                BETTERLISTINIT_FORCEINLINE constexpr proxy_iter &operator--() noexcept
+                {
+                    --pos;
+                    while (index > 0 && ends[index - 1] > pos)
+                        --index;
+                    return *this;
+                }
+                BETTERLISTINIT_FORCEINLINE constexpr proxy_iter operator++(int) noexcept
+                {
+                    proxy_iter ret = *this;
+                    ++*this;
+                    return ret;
+                }
+                BETTERLISTINIT_FORCEINLINE constexpr proxy_iter operator--(int) noexcept
+                {
+                    proxy_iter ret = *this;
+                    --*this;
+                    return ret;
+                }
+                BETTERLISTINIT_FORCEINLINE constexpr friend proxy_iter operator+(proxy_iter it, detail::ptrdiff_t n) noexcept {it += n; return it;}
+                BETTERLISTINIT_FORCEINLINE constexpr friend proxy_iter operator+(detail::ptrdiff_t n, proxy_iter it) noexcept {it += n; return it;}
+                BETTERLISTINIT_FORCEINLINE constexpr friend proxy_iter operator-(proxy_iter it, detail::ptrdiff_t n) noexcept {it -= n; return it;}
+                // There's no `number - iterator`.
+
+                BETTERLISTINIT_FORCEINLINE constexpr friend detail::ptrdiff_t operator-(proxy_iter a, proxy_iter b) noexcept {return detail::ptrdiff_t(a.pos) - detail::ptrdiff_t(b.pos);}
+
+                constexpr proxy_iter &operator+=(detail::ptrdiff_t n) noexcept {pos += detail::size_t(n); find_index(); return *this;}
+                constexpr proxy_iter &operator-=(detail::ptrdiff_t n) noexcept {pos -= detail::size_t(n); find_index(); return *this;}
+
+                BETTERLISTINIT_FORCEINLINE constexpr reference operator[](detail::ptrdiff_t i) const noexcept
+                {
+                    return *(*this + i);
+                }
+            };
+
+          public:
+            // The iterator type we use to initialize ranges of `T`.
+            // Unless there are spliced ranges, it doesn't depend on the list type: homogeneous lists iterate over the elements directly,
+            // and heterogeneous lists iterate over `elem_ref`s, which depend only on `T`.
+            // Lists of string literals iterate over `detail::char_array_ref`s, if `T` can be constructed from a pointer and a length.
+            // Lists whose elements normalize to the same type (see `custom::normalized_elem`) iterate over the normalized elements, like homogeneous lists.
+            template <typename T>
+            using iterator_t = std::conditional_t<has_spread_elems, proxy_iter<T>, detail::elem_iter<
+                std::conditional_t<uses_char_array_refs<T>::value, detail::char_array_ref<T, char_array_type>,
+                std::conditional_t<uses_normalized_elems<T>::value, typename detail::normalized_elem_ref<T, P...>::type,
+                std::conditional_t<is_homogeneous, homogeneous_type,
+                detail::elem_ref<T, detail::all_of<can_initialize_elem<T>, can_nothrow_initialize_elem<T>>::value>
+            >>>>>;
+
+          private:
+
+            // Points a pair of `proxy_iter`s to the elements of `list`. `ends` must have `sizeof...(P) + 1` elements, and must outlive the iterators.
+            // Returns the total size.
+            template <typename E, typename Tr>
+            BETTERLISTINIT_FORCEINLINE static constexpr detail::size_t bind_proxy_iters(const BETTERLISTINIT_IDENTIFIER &list, const Tr &transform, detail::size_t *ends, proxy_iter<E, Tr> &begin, proxy_iter<E, Tr> &end)
+            {
+                // Compute the sizes up front, so the iterators can report the exact total size, and the container can allocate once.
+                detail::size_t size = list.elems.apply(detail::elem_ends_functor{ends});
+
+                begin.target = end.target = &list.elems;
+                begin.transform = end.transform = &transform;
+                begin.ends = end.ends = ends;
+                end.pos = size;
+                begin.find_index();
+                end.find_index();
+                return size;
+            }
+
+            // Constructs a range `T` from a pair of `proxy_iter`s, applying the transformation `Tr` to the elements.
+            template <typename T, typename Tr, typename ...Q>
+            static constexpr T construct_range_from_proxies(const BETTERLISTINIT_IDENTIFIER &list, const Tr &transform, Q &&... extra_args)
+            {
+                using elem_type = typename custom::element_type<T>::type;
+
+                // The extra element is here to support empty lists.
+                detail::size_t ends[sizeof...(P) + 1]{};
+                proxy_iter<elem_type, Tr> begin, end;
+                detail::size_t size = bind_proxy_iters(list, transform, ends, begin, end);
+                (void)size;
+
+                #if BETTERLISTINIT_TRACE
+                detail::trace_scope<T, BETTERLISTINIT_IDENTIFIER> trace(trace_path::proxied, size);
+                #endif
+
+                return custom::construct_range<void, T, proxy_iter<elem_type, Tr>, BETTERLISTINIT_IDENTIFIER, Q...>{}(begin, end, static_cast<Q &&>(extra_args)...);
+            }
+
+            // Points the `elem_ref`s in `refs` (which must have `sizeof...(P)` elements) to the elements of `list`, skipping the disabled optional elements.
+            // Returns the number of used references.
+            template <typename Ref>
+            BETTERLISTINIT_FORCEINLINE static constexpr detail::size_t bind_elem_refs(const BETTERLISTINIT_IDENTIFIER &list, Ref *refs) noexcept
+            {
+                // Point them to the type-erased elements, see `detail::elem_holder`.
+                list.elems.get_holders(refs);
+                constexpr typename Ref::template construct_table<P &&...> table{};
+
+                // Skip the disabled optional elements, if any. This way the iterators remain random-access and report the exact size,
+                // so the container can allocate once.
+                // The indices are increasing, so we can compact the references in place.
+                // Otherwise we don't touch the indices at all, which matters in constant evaluation, where every store counts towards the limits.
+                detail::size_t indices[has_variable_size_elems ? sizeof...(P) : 1]{};
+                detail::size_t size = has_variable_size_elems ? list.elems.apply(detail::enabled_indices_functor{indices}) : sizeof...(P);
+                for (detail::size_t i = 0; i < size; i++)
+                {
+                    detail::size_t index = has_variable_size_elems ? indices[i] : i;
+                    if (has_variable_size_elems)
+                        refs[i].holder = refs[index].holder;
+                    refs[i].construct = table.funcs[index];
+                    #if BETTERLISTINIT_TRACE
+                    refs[i].index = i;
+                    refs[i].kind = table.kinds[index];
+                    #endif
+                }
+                return size;
+            }
+
+            // Points `refs` (which must have `sizeof...(P)` elements) to the elements of `list`, for lists of character arrays. Returns the number of references.
+            template <typename Ref>
+            BETTERLISTINIT_FORCEINLINE static constexpr detail::size_t bind_char_array_refs(const BETTERLISTINIT_IDENTIFIER &list, Ref *refs) noexcept
+            {
+                list.elems.apply(detail::char_array_refs_functor<Ref>{refs});
+                return sizeof...(P);
+            }
+
+            // Points a pair of iterators to the normalized elements of `list`, for ranges of `E`s. See `custom::normalized_elem`.
+            // Stores the pointers to the elements, and the elements themselves if they have to be converted first.
+            template <typename E, bool Materialize = detail::normalized_elem_ref<E, P...>::materialize>
+            struct normalized_storage
+            {
+                using value_type = std::remove_reference_t<typename detail::normalized_elem_ref<E, P...>::type>;
+                value_type *ptrs[sizeof...(P)]{};
+
+                BETTERLISTINIT_FORCEINLINE constexpr detail::size_t bind(const BETTERLISTINIT_IDENTIFIER &list, iterator_t<E> &begin, iterator_t<E> &end) noexcept
+                {
+                    list.elems.apply(detail::elem_ptrs_functor<value_type>{ptrs});
+                    begin.ptr = ptrs;
+                    end.ptr = ptrs + sizeof...(P);
+                    return sizeof...(P);
+                }
+            };
+            template <typename E>
+            struct normalized_storage<E, true>
+            {
+                using value_type = std::remove_reference_t<typename detail::normalized_elem_ref<E, P...>::type>;
+                value_type values[sizeof...(P)]{};
+                value_type *ptrs[sizeof...(P)]{};
+
+                BETTERLISTINIT_FORCEINLINE constexpr detail::size_t bind(const BETTERLISTINIT_IDENTIFIER &list, iterator_t<E> &begin, iterator_t<E> &end)
+                {
+                    list.elems.apply(detail::elem_values_functor<value_type>{values, ptrs});
+                    begin.ptr = ptrs;
+                    end.ptr = ptrs + sizeof...(P);
+                    return sizeof...(P);
+                }
+            };
+
+            // Could use `[[no_unique_address]]`, but it's our only member variable anyway.
+            // Can't store `elem_ref`s here directly, because we can't use a templated `operator T` in our elements,
+            // because it doesn't work correctly on MSVC (but not on GCC and Clang).
+            tuple_t elems;
+
+            // See the public `_helper`-less versions below.
+            // Note that we have to use a specialization here. Directly inheriting from `integral_constant` isn't enough, because it's not SFINAE-friendly (with respect to the `element_type<T>::type`).
+            template <typename Void, typename T, typename ...Q> struct can_initialize_range_helper : std::false_type {};
+            template <typename T, typename ...Q> struct can_initialize_range_helper        <std::enable_if_t<custom::is_range<T>::value && detail::constructible_from_iters        <T, iterator_t<typename custom::element_type<T>::type>, BETTERLISTINIT_IDENTIFIER, Q...>::value && can_initialize_elem        <typename custom::element_type<T>::type>::value>, T, Q...> : std::true_type {};
+            template <typename Void, typename T, typename ...Q> struct can_nothrow_initialize_range_helper : std::false_type {};
+            template <typename T, typename ...Q> struct can_nothrow_initialize_range_helper<std::enable_if_t<custom::is_range<T>::value && detail::nothrow_constructible_from_iters<T, iterator_t<typename custom::element_type<T>::type>, BETTERLISTINIT_IDENTIFIER, Q...>::value && can_nothrow_initialize_elem<typename custom::element_type<T>::type>::value>, T, Q...> : std::true_type {};
+
+            template <typename Void, typename T> struct range_uses_char_array_refs_helper : std::false_type {};
+            template <typename T> struct range_uses_char_array_refs_helper<std::enable_if_t<custom::is_range<T>::value && uses_char_array_refs<typename custom::element_type<T>::type>::value>, T> : std::true_type {};
+            // Whether `T` is a range, and `uses_char_array_refs` is true for its elements.
+            template <typename T> struct range_uses_char_array_refs : range_uses_char_array_refs_helper<void, T> {};
+            // Whether `T` is a range, and `uses_normalized_elems` is true for its elements.
+            template <typename T> struct range_uses_normalized_elems : detail::all_of<detail::negate<range_uses_char_array_refs<T>>, detail::range_uses_normalized_elems<T, P...>> {};
+
+          public:
+            // Whether this list can be used to initialize a range type `T`, with extra constructor arguments `Q...`.
+            template <typename T, typename ...Q> struct can_initialize_range         : can_initialize_range_helper        <void, T, Q...> {};
+            template <typename T, typename ...Q> struct can_nothrow_initialize_range : can_nothrow_initialize_range_helper<void, T, Q...> {};
+            // Whether this list can be used to initialize a non-range of type `T` (by forwarding arguments to the constructor), with extra constructor arguments `Q...`.
+            // NOTE: We check `!is_range<T>` here to avoid the uniform init fiasco, at least for our lists.
+            // NOTE: We need short-circuiting here, otherwise libstdc++ 10 in C++14 mode fails with a hard error in `nonrange_brace_constructible`.
+            // NOTE: `sizeof...(Q) == 0` is an arbitrary restriction, hopefully forcing a more clear usage.
+            // NOTE: Non-ranges can't skip the disabled optional elements nor splice ranges, so we reject them.
+            template <typename T, typename ...Q> struct can_initialize_nonrange         : detail::all_of<detail::negate<custom::is_range<T>>, std::integral_constant<bool, sizeof...(Q) == 0 && !has_variable_size_elems>, detail::nonrange_brace_constructible        <T, BETTERLISTINIT_IDENTIFIER, P..., Q...>> {};
+            template <typename T, typename ...Q> struct can_nothrow_initialize_nonrange : detail::all_of<detail::negate<custom::is_range<T>>, std::integral_constant<bool, sizeof...(Q) == 0 && !has_variable_size_elems>, detail::nothrow_nonrange_brace_constructible<T, BETTERLISTINIT_IDENTIFIER, P..., Q...>> {};
+
+          private:
+            template <typename T>
+            struct convert_functor
+            {
+                const BETTERLISTINIT_IDENTIFIER *list = nullptr;
+
+                // Convert to an empty range.
+                template <typename ...Q, std::enable_if_t<can_initialize_range<T, Q...>::value && sizeof...(P) == 0, detail::nullptr_t> = nullptr>
+                BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr T operator()(Q &&... extra_args) const
+                {
+                    detail::lint<T, P...>();
+                    #if BETTERLISTINIT_TRACE
+                    detail::trace_scope<T, BETTERLISTINIT_IDENTIFIER> trace(trace_path::empty, 0);
+                    #endif
+                    using iter_t = iterator_t<typename custom::element_type<T>::type>;
+                    return custom::construct_range<void, T, iter_t, BETTERLISTINIT_IDENTIFIER, Q...>{}(iter_t{}, iter_t{}, static_cast<Q &&>(extra_args)...);
+                }
+                // Convert to a non-empty heterogeneous range, without spliced ranges.
+                template <typename ...Q, std::enable_if_t<can_initialize_range<T, Q...>::value && sizeof...(P) != 0 && !is_homogeneous && !has_spread_elems && !range_uses_char_array_refs<T>::value && !range_uses_normalized_elems<T>::value, detail::nullptr_t> = nullptr>
+                BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr T operator()(Q &&... extra_args) const
+                {
+                    detail::lint<T, P...>();
+                    using iter_t = iterator_t<typename custom::element_type<T>::type>;
+
+                    // Must store `elem_ref`s here, because `std::random_access_iterator` requires `operator[]` to return the same type as `operator*`,
+                    // and `LegacyForwardIterator` requires `operator*` to return an actual reference. If we don't have those here, we don't have anything for the references to point to.
+                    typename iter_t::value_type::template array<sizeof...(P)> refs;
+                    detail::size_t size = bind_elem_refs(*list, refs.elems);
+
+                    #if BETTERLISTINIT_TRACE
+                    detail::trace_scope<T, BETTERLISTINIT_IDENTIFIER> trace(trace_path::heterogeneous, size);
+                    #endif
+
+                    iter_t begin, end;
+                    begin.ptr = refs.elems;
+                    end.ptr = refs.elems + size;
+
+                    return custom::construct_range<void, T, iter_t, BETTERLISTINIT_IDENTIFIER, Q...>{}(begin, end, static_cast<Q &&>(extra_args)...);
+                }
+                // Convert to a range with spliced ranges.
+                template <typename ...Q, std::enable_if_t<can_initialize_range<T, Q...>::value && has_spread_elems, detail::nullptr_t> = nullptr>
+                BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr T operator()(Q &&... extra_args) const
+                {
+                    detail::lint<T, P...>();
+                    return construct_range_from_proxies<T>(*list, detail::no_transform{}, static_cast<Q &&>(extra_args)...);
+                }
+                // Convert to a range from a list of character arrays, see `detail::char_array_ref`.
+                template <typename ...Q, std::enable_if_t<can_initialize_range<T, Q...>::value && range_uses_char_array_refs<T>::value, detail::nullptr_t> = nullptr>
+                BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr T operator()(Q &&... extra_args) const
+                {
+                    detail::lint<T, P...>();
+                    using iter_t = iterator_t<typename custom::element_type<T>::type>;
+
+                    #if BETTERLISTINIT_TRACE
+                    detail::trace_scope<T, BETTERLISTINIT_IDENTIFIER> trace(trace_path::homogeneous, sizeof...(P));
+                    for (detail::size_t i = 0; i < sizeof...(P); i++)
+                        detail::trace_element<typename custom::element_type<T>::type>(i, trace_element_kind::convert);
+                    #endif
+
+                    typename iter_t::value_type refs[sizeof...(P)];
+                    detail::size_t size = bind_char_array_refs(*list, refs);
+
+                    iter_t begin, end;
+                    begin.ptr = refs;
+                    end.ptr = refs + size;
+
+                    return custom::construct_range<void, T, iter_t, BETTERLISTINIT_IDENTIFIER, Q...>{}(begin, end, static_cast<Q &&>(extra_args)...);
+                }
+                // Convert to a range from a heterogeneous list, whose elements normalize to the same type. See `custom::normalized_elem`.
+                template <typename ...Q, std::enable_if_t<can_initialize_range<T, Q...>::value && range_uses_normalized_elems<T>::value, detail::nullptr_t> = nullptr>
+                BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr T operator()(Q &&... extra_args) const
+                {
+                    detail::lint<T, P...>();
+                    using elem_type = typename custom::element_type<T>::type;
+                    using iter_t = iterator_t<elem_type>;
+
+                    #if BETTERLISTINIT_TRACE
+                    detail::trace_scope<T, BETTERLISTINIT_IDENTIFIER> trace(trace_path::homogeneous, sizeof...(P));
+                    const trace_element_kind kinds[] = {detail::trace_kind<elem_type, P &&>::value...};
+                    for (detail::size_t i = 0; i < sizeof...(P); i++)
+                        detail::trace_element<elem_type>(i, kinds[i]);
+                    #endif
+
+                    normalized_storage<elem_type> storage;
+                    iter_t begin, end;
+                    storage.bind(*list, begin, end);
+
+                    return custom::construct_range<void, T, iter_t, BETTERLISTINIT_IDENTIFIER, Q...>{}(begin, end, static_cast<Q &&>(extra_args)...);
+                }
+                // Convert to a non-empty homogeneous range.
+                template <typename ...Q, std::enable_if_t<can_initialize_range<T, Q...>::value && sizeof...(P) != 0 && is_homogeneous && !range_uses_char_array_refs<T>::value, detail::nullptr_t> = nullptr>
+                BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr T operator()(Q &&... extra_args) const
+                {
+                    detail::lint<T, P...>();
+                    using iter_t = iterator_t<typename custom::element_type<T>::type>;
+
+                    #if BETTERLISTINIT_TRACE
+                    detail::trace_scope<T, BETTERLISTINIT_IDENTIFIER> trace(trace_path::homogeneous, sizeof...(P));
+                    using elem_type = typename custom::element_type<T>::type;
+                    for (detail::size_t i = 0; i < sizeof...(P); i++)
+                        detail::trace_element<elem_type>(i, detail::trace_kind<elem_type, homogeneous_type>::value);
+                    #endif
+
+                    iter_t begin, end;
+                    begin.ptr = list->elems.values;
+                    end.ptr = list->elems.values + sizeof...(P);
+
+                    return custom::construct_range<void, T, iter_t, BETTERLISTINIT_IDENTIFIER, Q...>{}(begin, end, static_cast<Q &&>(extra_args)...);
+                }
+                // Convert to a non-range.
+                template <typename ...Q, std::enable_if_t<can_initialize_nonrange<T, Q...>::value, detail::nullptr_t> = nullptr>
+                BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr T operator()(Q &&... extra_args) const
+                {
+                    detail::lint<T, P...>();
+                    #if BETTERLISTINIT_TRACE
+                    detail::trace_scope<T, BETTERLISTINIT_IDENTIFIER> trace(trace_path::nonrange, sizeof...(P));
+                    #endif
+                    detail::tuple<Q &&...> extra_tuple{&extra_args...};
+                    using func_t = custom::construct_nonrange<void, T, BETTERLISTINIT_IDENTIFIER, P..., Q...>;
+                    return extra_tuple.apply(detail::apply_functor<func_t, const tuple_t &>{func_t{}, list->elems});
+                }
+            };
+
+            template <typename Void, typename T, typename ...Q> struct can_nothrow_initialize_helper : can_nothrow_initialize_nonrange<T, Q...> {};
+            template <typename T, typename ...Q> struct can_nothrow_initialize_helper<std::enable_if_t<custom::is_range<T>::value>, T, Q...> : can_nothrow_initialize_range<T, Q...> {};
+
+            template <typename Void, typename T, typename ...Q>
+            struct allow_implicit_init_helper : custom::allow_implicit_nonrange_init<void, T, P..., Q...> {};
+            template <typename T, typename ...Q>
+            struct allow_implicit_init_helper<std::enable_if_t<custom::is_range<T>::value>, T, Q...> : custom::allow_implicit_range_init<void, T, Q.../*note, no P...*/> {};
+
+          public:
+            // Whether this list can be used to initialize a type `T`, with extra constructor arguments `Q...`.
+            // Returns true if `can_initialize_range<T,Q...>` or `can_initialize_nonrange<T,Q...>` is true.
+            template <typename T, typename ...Q> struct can_initialize : detail::any_of<can_initialize_range<T, Q...>, can_initialize_nonrange<T, Q...>> {};
+            template <typename T, typename ...Q> struct can_nothrow_initialize : can_nothrow_initialize_helper<void, T, Q...> {};
+
+            // Whether the conversion to `T` should be implicit, for extra constructor arguments `Q...`.
+            template <typename T, typename ...Q>
+            struct allow_implicit_init : allow_implicit_init_helper<void, T, Q...> {};
+
+            // The constructor from a braced (or parenthesized) list.
+            // No `[[nodiscard]]` because GCC 9 complains. Having it on the entire class should be enough.
+            BETTERLISTINIT_FORCEINLINE constexpr BETTERLISTINIT_IDENTIFIER(P &&... params) noexcept
+                : elems{&params...}
+            {}
 
-            // Whether all types in `P...` are the same (and there is at least one type). Then we can simplify some logic.
-            // static constexpr bool is_homogeneous = detail::all_types_same<P...>::value && sizeof...(P) > 0;
-            static constexpr bool is_homogeneous = detail::all_types_same<P...>::value && sizeof...(P) > 0;
-            // If all types in `P...` are the same (and there's at least one), returns that type. Otherwise returns an empty struct.
-            using homogeneous_type = typename std::conditional_t<is_homogeneous, detail::first_type<P &&...>, std::enable_if<true, detail::empty>>::type;
+            // Only copyable if `is_lvalue_only` is true.
 
-            // Whether all our references are lvalue references. Such lists can be copied.
-            static constexpr bool is_lvalue_only = detail::all_of<std::is_lvalue_reference<P>...>::value;
+            // The conversion functions below are `&&`-qualified as a reminder that your initializer elements can be dangling,
+            // unless the list only contains lvalues.
 
-          private:
-            using tuple_t = detail::tuple<P &&...>;
+            // Conversion operators.
+            // Those work with both ranges (constructible from a pair of iterators) and non-ranges (constructible from braced lists).
+            // Note that non-ranges can't use `(...)`, because `std::array` is a non-range and we want to support it too (including pre-C++20).
+            // Note that the uniform init fiasco is impossible for our lists, since we allow braced init only if `detail::is_range<T>` is false.
 
-            // Heterogeneous lists use this as the element type for the iterators.
-            template <typename T>
-            class elem_ref : detail::elem_ref_base
+            // Implicit, lvalue-only lists.
+            template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<can_initialize<T>::value && allow_implicit_init<T>::value && is_lvalue_only, detail::nullptr_t> = nullptr>
+            BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr operator T() const & noexcept(can_nothrow_initialize<T>::value)
+            {
+                return convert_functor<T>{this}();
+            }
+            // Explicit, lvalue-only lists.
+            template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<can_initialize<T>::value && !allow_implicit_init<T>::value && is_lvalue_only, detail::nullptr_t> = nullptr>
+            BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr explicit operator T() const & noexcept(can_nothrow_initialize<T>::value)
+            {
+                return convert_functor<T>{this}();
+            }
+            // Implicit, non-lvalue-only lists.
+            template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<can_initialize<T>::value && allow_implicit_init<T>::value && !is_lvalue_only, detail::nullptr_t> = nullptr>
+            BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr operator T() const && noexcept(can_nothrow_initialize<T>::value)
+            {
+                return convert_functor<T>{this}();
+            }
+            // Explicit, non-lvalue-only lists.
+            template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<can_initialize<T>::value && !allow_implicit_init<T>::value && !is_lvalue_only, detail::nullptr_t> = nullptr>
+            BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr explicit operator T() const && noexcept(can_nothrow_initialize<T>::value)
+            {
+                return convert_functor<T>{this}();
+            }
+
+          private:
+            // This is used to convert to ranges with extra constructor arguments.
+            template <typename ...Q>
+            class conversion_helper
             {
                 friend BETTERLISTINIT_IDENTIFIER;
-                const tuple_t *target = nullptr;
-                detail::size_t index = 0;
+                const BETTERLISTINIT_IDENTIFIER *list = nullptr;
+                detail::tuple<Q &&...> extra_params;
 
-                constexpr elem_ref() {}
+                BETTERLISTINIT_FORCEINLINE constexpr conversion_helper(const BETTERLISTINIT_IDENTIFIER *list, detail::tuple<Q &&...> extra_params)
+                    : list(list), extra_params(extra_params)
+                {}
 
               public:
-                // Non-copyable.
-                // The list creates and owns all its references, and exposes actual references to them.
-                // This is because pre-C++20 iterator requirements force us to return actual references from `*`, and more importantly `[]`.
-                elem_ref(const elem_ref &) = delete;
-                elem_ref &operator=(const elem_ref &) = delete;
-
-                // MSVC is bugged and refuses to let us default-construct references in some scenarios, despite `init` being our `friend`.
-                // We work around this by creating arrays here.
-                template <detail::size_t N>
-                struct array
-                {
-                    elem_ref elems[N];
-                    constexpr array() {}
-                };
-
-                // Note that this is unnecessary when `is_homogeneous` is true, because in that case our iterator
-                // dereferences directly to `homogeneous_type`.
-                constexpr operator T() const noexcept(can_nothrow_initialize_elem<T>::value)
+                // Implicit, lvalue-only lists.
+                template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<can_initialize<T, Q...>::value && allow_implicit_init<T, Q...>::value && is_lvalue_only, detail::nullptr_t> = nullptr>
+                BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr operator T() const & noexcept(can_nothrow_initialize<T, Q...>::value)
                 {
-                    return target->template apply_to_elem<detail::construct_from_elem<T>>(index);
+                    return extra_params.apply(convert_functor<T>{list});
                 }
-
-                #if BETTERLISTINIT_ALLOCATOR_HACK
-                // Constructs an object at the specified address, using an allocator.
-                template <typename Alloc>
-                constexpr void _allocator_hack_construct_at(Alloc &alloc, T *location) const noexcept(can_nothrow_initialize_elem<T>::value)
+                // Explicit, lvalue-only lists.
+                template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<can_initialize<T, Q...>::value && !allow_implicit_init<T, Q...>::value && is_lvalue_only, detail::nullptr_t> = nullptr>
+                BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr explicit operator T() const & noexcept(can_nothrow_initialize<T, Q...>::value)
                 {
-                    target->template apply_to_elem<detail::allocator_hack::construct_from_elem_at<T, Alloc>>(index, alloc, location);
+                    return extra_params.apply(convert_functor<T>{list});
+                }
+                // Implicit, non-lvalue-only lists.
+                template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<can_initialize<T, Q...>::value && allow_implicit_init<T, Q...>::value && !is_lvalue_only, detail::nullptr_t> = nullptr>
+                BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr operator T() const && noexcept(can_nothrow_initialize<T, Q...>::value)
+                {
+                    return extra_params.apply(convert_functor<T>{list});
+                }
+                // Explicit, non-lvalue-only lists.
+                template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<can_initialize<T, Q...>::value && !allow_implicit_init<T, Q...>::value && !is_lvalue_only, detail::nullptr_t> = nullptr>
+                BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr explicit operator T() const && noexcept(can_nothrow_initialize<T, Q...>::value)
+                {
+                    return extra_params.apply(convert_functor<T>{list});
                 }
-                #endif
             };
 
-            // The iterator class.
-            // Homogeneous lists ignore `T` here.
-            template <typename T>
-            class elem_iter
+          public:
+            // Returns a helper object with conversion operators.
+            // `extra_params...` are the extra parameters passed to the type's constructor, after the pair of iterators.
+            template <typename ...Q>
+            BETTERLISTINIT_NODISCARD constexpr conversion_helper<Q &&...> and_with(Q &&... extra_params) const && noexcept
+            {
+                return {this, {&extra_params...}};
+            }
+
+          private:
+            // Whether this list can be used to initialize a range type `T`, after applying a transformation `Tr` to the elements.
+            template <typename Void, typename T, typename Tr> struct can_initialize_transformed_range_helper : std::false_type {};
+            template <typename T, typename Tr> struct can_initialize_transformed_range_helper        <std::enable_if_t<custom::is_range<T>::value && detail::constructible_from_iters        <T, proxy_iter<typename custom::element_type<T>::type, Tr>, BETTERLISTINIT_IDENTIFIER>::value && can_initialize_transformed_elem        <typename custom::element_type<T>::type, Tr>::value>, T, Tr> : std::true_type {};
+            template <typename Void, typename T, typename Tr> struct can_nothrow_initialize_transformed_range_helper : std::false_type {};
+            template <typename T, typename Tr> struct can_nothrow_initialize_transformed_range_helper<std::enable_if_t<custom::is_range<T>::value && detail::nothrow_constructible_from_iters<T, proxy_iter<typename custom::element_type<T>::type, Tr>, BETTERLISTINIT_IDENTIFIER>::value && can_nothrow_initialize_transformed_elem<typename custom::element_type<T>::type, Tr>::value>, T, Tr> : std::true_type {};
+            template <typename T, typename Tr> struct can_initialize_transformed_range         : can_initialize_transformed_range_helper        <void, T, Tr> {};
+            template <typename T, typename Tr> struct can_nothrow_initialize_transformed_range : can_nothrow_initialize_transformed_range_helper<void, T, Tr> {};
+
+            // This is returned by `.transform(func)`. Converts to ranges, applying `func` to the elements.
+            template <typename F, bool Indexed>
+            class transform_helper
             {
                 friend BETTERLISTINIT_IDENTIFIER;
-                const std::conditional_t<is_homogeneous, std::remove_reference_t<homogeneous_type> *, elem_ref<T>> *ptr = nullptr;
+                using transform_t = detail::transform_func<F, Indexed>;
+                const BETTERLISTINIT_IDENTIFIER *list = nullptr;
+                transform_t transform;
+
+                BETTERLISTINIT_FORCEINLINE constexpr transform_helper(const BETTERLISTINIT_IDENTIFIER *list, F *func)
+                    : list(list), transform{func}
+                {}
 
-                template <typename Void = void, std::enable_if_t<detail::dependent_value<Void, !is_homogeneous>::value, detail::nullptr_t> = nullptr>
-                constexpr auto &deref() const
+              public:
+                // Implicit, lvalue-only lists.
+                template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<can_initialize_transformed_range<T, transform_t>::value && allow_implicit_init<T>::value && is_lvalue_only, detail::nullptr_t> = nullptr>
+                BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr operator T() const & noexcept(can_nothrow_initialize_transformed_range<T, transform_t>::value)
+                {
+                    return construct_range_from_proxies<T>(*list, transform);
+                }
+                // Explicit, lvalue-only lists.
+                template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<can_initialize_transformed_range<T, transform_t>::value && !allow_implicit_init<T>::value && is_lvalue_only, detail::nullptr_t> = nullptr>
+                BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr explicit operator T() const & noexcept(can_nothrow_initialize_transformed_range<T, transform_t>::value)
                 {
-                    return *ptr;
+                    return construct_range_from_proxies<T>(*list, transform);
                 }
-                template <typename Void = void, std::enable_if_t<detail::dependent_value<Void, is_homogeneous>::value, detail::nullptr_t> = nullptr>
-                constexpr auto &&deref() const
+                // Implicit, non-lvalue-only lists.
+                template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<can_initialize_transformed_range<T, transform_t>::value && allow_implicit_init<T>::value && !is_lvalue_only, detail::nullptr_t> = nullptr>
+                BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr operator T() const && noexcept(can_nothrow_initialize_transformed_range<T, transform_t>::value)
+                {
+                    return construct_range_from_proxies<T>(*list, transform);
+                }
+                // Explicit, non-lvalue-only lists.
+                template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<can_initialize_transformed_range<T, transform_t>::value && !allow_implicit_init<T>::value && !is_lvalue_only, detail::nullptr_t> = nullptr>
+                BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr explicit operator T() const && noexcept(can_nothrow_initialize_transformed_range<T, transform_t>::value)
                 {
-                    return static_cast<homogeneous_type>(**ptr);
+                    return construct_range_from_proxies<T>(*list, transform);
                 }
+            };
 
-              public:
-                // Can't use C++20 iterator category auto-detection here, since an rvalue reference `reference` makes it think it's an input iterator.
-                // Yes, the detection logic is specified to not match the actual iterator requirements, this is LWG issue: https://cplusplus.github.io/LWG/issue3798
-                using iterator_category = std::random_access_iterator_tag;
-                using reference = std::conditional_t<is_homogeneous, homogeneous_type, const elem_ref<T> &>;
-                using value_type = std::remove_cv_t<std::remove_reference_t<reference>>;
-                using pointer = void;
-                using difference_type = detail::ptrdiff_t;
+          public:
+            // Returns a helper object that converts to ranges, calling `func(elem)` on each element (forwarded) first: `std::vector<W> vec = init{a, b}.transform(wrap);`.
+            // The results are passed directly to the element constructors, without intermediate containers.
+            // If `func` returns the element type by value, it's constructed in place (thanks to the mandatory copy elision), so it doesn't need to be movable.
+            template <typename F>
+            BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr transform_helper<std::remove_reference_t<F>, false> transform(F &&func) const && noexcept
+            {
+                return {this, &func};
+            }
+            // Same, but calls `func(i, elem)`, where `i` is the element index in the target range.
+            template <typename F>
+            BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr transform_helper<std::remove_reference_t<F>, true> transform_indexed(F &&func) const && noexcept
+            {
+                return {this, &func};
+            }
+
+          private:
+            // Checks that constructing a `T` from the `I`th element, of type `U`, isn't a copy. See `.strict()`.
+            template <detail::size_t I, typename T, typename U>
+            struct strict_elem_check
+            {
+                static_assert(!custom::is_element_copy<T, U>::value, "`init{...}.strict()`: This element would be copied. Move it, or copy it explicitly by passing a prvalue: `T(elem)`. "
+                    "The template arguments of this class are the element index `I`, the range element type `T`, and the list element type `U`.");
+                static constexpr bool value = true;
+            };
 
-                constexpr elem_iter() noexcept {}
+            template <typename T, typename I = detail::make_index_sequence<sizeof...(P)>>
+            struct strict_check {};
+            template <typename T, detail::size_t ...I>
+            struct strict_check<T, detail::index_sequence<I...>>
+                : detail::all_of_flat<strict_elem_check<I, typename custom::element_type<T>::type, typename detail::elem_traits<P>::elem_type>...>
+            {};
 
-                // `LegacyForwardIterator` requires us to return an actual reference here.
-                constexpr reference operator*() const noexcept {return deref();}
+            // This is returned by `.strict()`. Converts to ranges, rejecting elements that would be copied.
+            class strict_helper
+            {
+                friend BETTERLISTINIT_IDENTIFIER;
+                const BETTERLISTINIT_IDENTIFIER *list = nullptr;
 
-                // No `operator->`. This causes C++20 `std::iterator_traits` to guess `pointer_type == void`, which sounds ok to me.
+                BETTERLISTINIT_FORCEINLINE constexpr strict_helper(const BETTERLISTINIT_IDENTIFIER *list) : list(list) {}
 
-                // Don't want to rely on `<compare>`.
-                friend constexpr bool operator==(elem_iter a, elem_iter b) noexcept
+              public:
+                // Implicit, lvalue-only lists.
+                template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<custom::is_range<T>::value && can_initialize<T>::value && allow_implicit_init<T>::value && is_lvalue_only, detail::nullptr_t> = nullptr>
+                BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr operator T() const & noexcept(can_nothrow_initialize<T>::value)
+                {
+                    static_assert(strict_check<T>::value, "See the previous error.");
+                    return convert_functor<T>{list}();
+                }
+                // Explicit, lvalue-only lists.
+                template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<custom::is_range<T>::value && can_initialize<T>::value && !allow_implicit_init<T>::value && is_lvalue_only, detail::nullptr_t> = nullptr>
+                BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr explicit operator T() const & noexcept(can_nothrow_initialize<T>::value)
                 {
-                    return a.ptr == b.ptr;
+                    static_assert(strict_check<T>::value, "See the previous error.");
+                    return convert_functor<T>{list}();
                 }
-                friend constexpr bool operator!=(elem_iter a, elem_iter b) noexcept
+                // Implicit, non-lvalue-only lists.
+                template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<custom::is_range<T>::value && can_initialize<T>::value && allow_implicit_init<T>::value && !is_lvalue_only, detail::nullptr_t> = nullptr>
+                BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr operator T() const && noexcept(can_nothrow_initialize<T>::value)
                 {
-                    return !(a == b);
+                    static_assert(strict_check<T>::value, "See the previous error.");
+                    return convert_functor<T>{list}();
                 }
-                friend constexpr bool operator<(elem_iter a, elem_iter b) noexcept
+                // Explicit, non-lvalue-only lists.
+                template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<custom::is_range<T>::value && can_initialize<T>::value && !allow_implicit_init<T>::value && !is_lvalue_only, detail::nullptr_t> = nullptr>
+                BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr explicit operator T() const && noexcept(can_nothrow_initialize<T>::value)
                 {
-                    // Don't want to include `<functional>` for `std::less`, so need to cast to an integer to avoid UB.
-                    return detail::uintptr_t(a.ptr) < detail::uintptr_t(b.ptr);
+                    static_assert(strict_check<T>::value, "See the previous error.");
+                    return convert_functor<T>{list}();
                 }
-                friend constexpr bool operator> (elem_iter a, elem_iter b) noexcept {return b < a;}
-                friend constexpr bool operator<=(elem_iter a, elem_iter b) noexcept {return !(b < a);}
-                friend constexpr bool operator>=(elem_iter a, elem_iter b) noexcept {return !(a < b);}
+            };
+
+          public:
+            // Returns a helper object that converts to ranges like the list itself, but fails to compile if any element would be copied,
+            // rather than moved: `std::vector<std::string> vec = init{std::move(a), b}.strict(); // Error, `b` is copied.`
+            // What counts as a copy is determined by `custom::is_element_copy`. Conversions from other types are allowed by default.
+            // Non-ranges are not supported, since we don't know their element types.
+            BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr strict_helper strict() const && noexcept
+            {
+                return {this};
+            }
+
+            #if BETTERLISTINIT_PARALLEL
+          private:
+            // Whether this list can be used to initialize `T` in parallel, see `detail::parallel_target`.
+            template <typename Void, typename T> struct can_initialize_in_parallel_helper : std::false_type {};
+            template <typename T> struct can_initialize_in_parallel_helper<std::enable_if_t<detail::constructible_from_iters<typename detail::parallel_target<T>::builder, proxy_iter<typename custom::element_type<typename detail::parallel_target<T>::builder>::type>, BETTERLISTINIT_IDENTIFIER, parallel_options>::value && can_initialize_elem<typename custom::element_type<typename detail::parallel_target<T>::builder>::type>::value>, T> : std::true_type {};
+            template <typename T> struct can_initialize_in_parallel : can_initialize_in_parallel_helper<void, T> {};
+
+            template <typename T>
+            static T construct_in_parallel(const BETTERLISTINIT_IDENTIFIER &list, parallel_options options)
+            {
+                using target = detail::parallel_target<T>;
+                return target::finish(construct_range_from_proxies<typename target::builder>(list, detail::no_transform{}, static_cast<parallel_options &&>(options)));
+            }
+
+            // This is returned by `.parallel()`. Converts to ranges, constructing the elements on several threads.
+            class parallel_helper
+            {
+                friend BETTERLISTINIT_IDENTIFIER;
+                const BETTERLISTINIT_IDENTIFIER *list = nullptr;
+                parallel_options options;
+
+                constexpr parallel_helper(const BETTERLISTINIT_IDENTIFIER *list, parallel_options options)
+                    : list(list), options(options)
+                {}
 
-                constexpr elem_iter &operator++() noexcept
+              public:
+                // Implicit, lvalue-only lists.
+                template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<can_initialize_in_parallel<T>::value && detail::parallel_target<T>::allow_implicit && is_lvalue_only, detail::nullptr_t> = nullptr>
+                BETTERLISTINIT_NODISCARD operator T() const &
                 {
-                    ++ptr;
-                    return *this;
+                    return construct_in_parallel<T>(*list, options);
                 }
-                constexpr elem_iter &operator--() noexcept
+                // Explicit, lvalue-only lists.
+                template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<can_initialize_in_parallel<T>::value && !detail::parallel_target<T>::allow_implicit && is_lvalue_only, detail::nullptr_t> = nullptr>
+                BETTERLISTINIT_NODISCARD explicit operator T() const &
                 {
-                    --ptr;
-                    return *this;
+                    return construct_in_parallel<T>(*list, options);
                 }
-                constexpr elem_iter operator++(int) noexcept
+                // Implicit, non-lvalue-only lists.
+                template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<can_initialize_in_parallel<T>::value && detail::parallel_target<T>::allow_implicit && !is_lvalue_only, detail::nullptr_t> = nullptr>
+                BETTERLISTINIT_NODISCARD operator T() const &&
                 {
-                    elem_iter ret = *this;
-                    ++*this;
-                    return ret;
+                    return construct_in_parallel<T>(*list, options);
                 }
-                constexpr elem_iter operator--(int) noexcept
+                // Explicit, non-lvalue-only lists.
+                template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<can_initialize_in_parallel<T>::value && !detail::parallel_target<T>::allow_implicit && !is_lvalue_only, detail::nullptr_t> = nullptr>
+                BETTERLISTINIT_NODISCARD explicit operator T() const &&
                 {
-                    elem_iter ret = *this;
-                    --*this;
-                    return ret;
+                    return construct_in_parallel<T>(*list, options);
                 }
-                constexpr friend elem_iter operator+(elem_iter it, detail::ptrdiff_t n) noexcept {it += n; return it;}
-                constexpr friend elem_iter operator+(detail::ptrdiff_t n, elem_iter it) noexcept {it += n; return it;}
-                constexpr friend elem_iter operator-(elem_iter it, detail::ptrdiff_t n) noexcept {it -= n; return it;}
-                // There's no `number - iterator`.
+            };
+
+          public:
+            // Returns a helper object that converts to ranges, constructing the elements on up to `threads` threads (zero = the hardware concurrency):
+            // `std::vector<std::regex> vec = init{...}.parallel();`. This is only worth it when the element constructors are expensive.
+            // Each element is constructed exactly once, but the order is unspecified.
+            // `fixed_buffer<T>` and `std::unique_ptr<T[], fixed_buffer_deleter<T>>` are constructed in place.
+            // Other ranges are constructed in a temporary `fixed_buffer` first, then the elements are moved to them.
+            // If any element throws, all constructed elements are destroyed, and the first exception is rethrown.
+            BETTERLISTINIT_NODISCARD constexpr parallel_helper parallel(unsigned threads = 0) const && noexcept
+            {
+                return {this, {threads}};
+            }
+            #endif
+
+            #if BETTERLISTINIT_ARENA
+          private:
+            // Whether this list can initialize `T` with a `std::pmr::polymorphic_allocator`, see `in_arena()`.
+            template <typename Void, typename T> struct can_initialize_in_arena_helper : std::false_type {};
+            template <typename T> struct can_initialize_in_arena_helper<std::enable_if_t<custom::is_range<T>::value && std::is_constructible<typename T::allocator_type, std::pmr::memory_resource *>::value && can_initialize<T, typename T::allocator_type &>::value>, T> : std::true_type {};
+            template <typename T> struct can_initialize_in_arena : can_initialize_in_arena_helper<void, T> {};
 
-                constexpr friend detail::ptrdiff_t operator-(elem_iter a, elem_iter b) noexcept {return a.ptr - b.ptr;}
+            // This is returned by `.in_arena()`. Converts to `arena<T>`.
+            class arena_helper
+            {
+                friend BETTERLISTINIT_IDENTIFIER;
+                const BETTERLISTINIT_IDENTIFIER *list = nullptr;
+                detail::size_t extra_bytes = 0;
 
-                constexpr elem_iter &operator+=(detail::ptrdiff_t n) noexcept {ptr += n; return *this;}
-                constexpr elem_iter &operator-=(detail::ptrdiff_t n) noexcept {ptr -= n; return *this;}
+                constexpr arena_helper(const BETTERLISTINIT_IDENTIFIER *list, detail::size_t extra_bytes)
+                    : list(list), extra_bytes(extra_bytes)
+                {}
 
-                constexpr reference operator[](detail::ptrdiff_t i) const noexcept
+                template <typename T>
+                arena<T> construct() const
                 {
-                    return *(*this + i);
+                    detail::size_t ends[sizeof...(P) + 1]{};
+                    detail::size_t size = list->elems.apply(detail::elem_ends_functor{ends});
+
+                    return arena<T>(detail::arena_size<T>(size) + extra_bytes, [&](std::pmr::memory_resource *resource)
+                    {
+                        typename T::allocator_type alloc(resource);
+                        return static_cast<T>(static_cast<const BETTERLISTINIT_IDENTIFIER &&>(*list).and_with(alloc));
+                    });
+                }
+
+              public:
+                template <typename T, std::enable_if_t<can_initialize_in_arena<T>::value && is_lvalue_only, detail::nullptr_t> = nullptr>
+                BETTERLISTINIT_NODISCARD operator arena<T>() const &
+                {
+                    return construct<T>();
+                }
+                template <typename T, std::enable_if_t<can_initialize_in_arena<T>::value && !is_lvalue_only, detail::nullptr_t> = nullptr>
+                BETTERLISTINIT_NODISCARD operator arena<T>() const &&
+                {
+                    return construct<T>();
                 }
             };
 
-            // Could use `[[no_unique_address]]`, but it's our only member variable anyway.
-            // Can't store `elem_ref`s here directly, because we can't use a templated `operator T` in our elements,
-            // because it doesn't work correctly on MSVC (but not on GCC and Clang).
-            tuple_t elems;
+          public:
+            // Returns a helper object that converts to `arena<T>`, where `T` is a container using `std::pmr::polymorphic_allocator`:
+            // `better_list_init::arena<std::pmr::map<int, std::pmr::string>> map = init{...}.in_arena();`.
+            // The container is constructed with `.and_with(allocator)`, and its memory resource is sized up front for all elements (see `detail::arena_size()`),
+            // so all nodes end up in a single contiguous block.
+            // The nested allocations (e.g. of `std::pmr::string` elements) come from the same resource. Reserve `extra_bytes` for them.
+            BETTERLISTINIT_NODISCARD constexpr arena_helper in_arena(detail::size_t extra_bytes = 0) const && noexcept
+            {
+                return {this, extra_bytes};
+            }
+            #endif
+
+          private:
+            // Whether `.construct_at(target)` can construct `T`s.
+            template <typename T>
+            struct can_construct_at : detail::all_of<std::integral_constant<bool, !has_spread_elems && !std::is_const<T>::value>, can_initialize_elem<T>> {};
+
+          public:
+            // Constructs the elements as `T`s in uninitialized storage starting at `target`, and returns their number. Like `std::uninitialized_copy()`,
+            // but the elements are constructed directly from the list elements, without temporaries, so they don't need to be movable (even before C++17).
+            // `target` must have room for `sizeof...(P)` elements. Fewer are constructed if some optional elements are disabled.
+            // If a constructor throws, the already constructed elements are destroyed, and the exception is propagated.
+            // Not for lists with spliced ranges, since their size isn't known in advance.
+            // Lvalue-only.
+            template <typename T, std::enable_if_t<can_construct_at<T>::value && detail::dependent_value<T, is_lvalue_only>::value, detail::nullptr_t> = nullptr>
+            detail::size_t construct_at(T *target) const &
+            {
+                return elems.apply(detail::construct_at_functor<T>{target});
+            }
+            // Non-lvalue-only.
+            template <typename T, std::enable_if_t<can_construct_at<T>::value && detail::dependent_value<T, !is_lvalue_only>::value, detail::nullptr_t> = nullptr>
+            detail::size_t construct_at(T *target) const &&
+            {
+                return elems.apply(detail::construct_at_functor<T>{target});
+            }
+
+            #if BETTERLISTINIT_COROUTINES
+          private:
+            // Whether the list can be awaited: every element must be awaitable, with a non-void movable result.
+            static constexpr bool can_gather = !has_variable_size_elems && detail::all_of_flat<detail::can_gather_elem<P>...>::value;
+
+          public:
+            // Awaits all elements concurrently, by starting them as jobs on the `executor`, which must have `.post(std::coroutine_handle<>)`.
+            // Returns an `init{...}` list of the results: `std::vector<int> v = co_await init{task_a(), task_b()}.when_all(pool);`.
+            // The results are stored in the returned awaitable until the end of the full-expression, so convert them to something before that.
+            // If any element throws, the first exception is rethrown, after all elements finish. The executor is stored by reference if it's an lvalue.
+            // The awaiting coroutine is resumed on the thread that finishes the last element.
+            // Lvalue-only.
+            template <typename Executor, std::enable_if_t<detail::dependent_value<Executor, can_gather && is_lvalue_only>::value, detail::nullptr_t> = nullptr>
+            BETTERLISTINIT_NODISCARD detail::gather_awaitable<Executor, P...> when_all(Executor &&executor) const &
+            {
+                return elems.apply(detail::gather_functor<Executor>{static_cast<Executor &&>(executor)});
+            }
+            // Non-lvalue-only.
+            template <typename Executor, std::enable_if_t<detail::dependent_value<Executor, can_gather && !is_lvalue_only>::value, detail::nullptr_t> = nullptr>
+            BETTERLISTINIT_NODISCARD detail::gather_awaitable<Executor, P...> when_all(Executor &&executor) const &&
+            {
+                return elems.apply(detail::gather_functor<Executor>{static_cast<Executor &&>(executor)});
+            }
+
+            // `co_await init{...}` is the same as `co_await init{...}.when_all(inline_executor{})`.
+            // The elements start in order, each one when the previous one suspends.
+            // Lvalue-only.
+            template <detail::deduce..., typename Void = void, std::enable_if_t<detail::dependent_value<Void, can_gather && is_lvalue_only>::value, detail::nullptr_t> = nullptr>
+            BETTERLISTINIT_NODISCARD detail::gather_awaitable<inline_executor, P...> operator co_await() const &
+            {
+                return when_all(inline_executor{});
+            }
+            // Non-lvalue-only.
+            template <detail::deduce..., typename Void = void, std::enable_if_t<detail::dependent_value<Void, can_gather && !is_lvalue_only>::value, detail::nullptr_t> = nullptr>
+            BETTERLISTINIT_NODISCARD detail::gather_awaitable<inline_executor, P...> operator co_await() const &&
+            {
+                return static_cast<const BETTERLISTINIT_IDENTIFIER &&>(*this).when_all(inline_executor{});
+            }
+            #endif
+
+            #if BETTERLISTINIT_BOXED
+          private:
+            // Whether `.boxed<Base>()` is allowed: every element must be an object derived from `Base` (or `Base` itself), constructible from the element.
+            template <typename Base>
+            struct can_box : detail::all_of_flat<
+                std::integral_constant<bool, !has_variable_size_elems>,
+                std::is_base_of<Base, std::remove_cv_t<std::remove_reference_t<P>>>...,
+                detail::constructible<std::remove_cv_t<std::remove_reference_t<P>>, P &&>...
+            > {};
+
+          public:
+            // Constructs a copy of each element (moving from rvalues), as objects derived from `Base`, in a single memory block.
+            // `better_list_init::poly_buffer<Shape> shapes = init{Circle(1), Square(2)}.boxed<Shape>();`.
+            // The block layout is computed at compile-time, so this is a single allocation, and the objects are next to each other in memory.
+            // Lvalue-only.
+            template <typename Base, std::enable_if_t<can_box<Base>::value && detail::dependent_value<Base, is_lvalue_only>::value, detail::nullptr_t> = nullptr>
+            BETTERLISTINIT_NODISCARD poly_buffer<Base> boxed() const &
+            {
+                return elems.apply(detail::boxed_functor<Base>{});
+            }
+            // Non-lvalue-only.
+            template <typename Base, std::enable_if_t<can_box<Base>::value && detail::dependent_value<Base, !is_lvalue_only>::value, detail::nullptr_t> = nullptr>
+            BETTERLISTINIT_NODISCARD poly_buffer<Base> boxed() const &&
+            {
+                return elems.apply(detail::boxed_functor<Base>{});
+            }
+            #endif
+
+            // Begin/end iterators, for homogeneous lists only.
+
+            // Lvalue-only.
+            template <detail::deduce..., typename Void = void, std::enable_if_t<detail::dependent_value<Void, is_homogeneous && is_lvalue_only>::value, detail::nullptr_t> = nullptr>
+            detail::elem_iter<homogeneous_type> begin() const & noexcept
+            {
+                detail::elem_iter<homogeneous_type> ret;
+                ret.ptr = elems.values;
+                return ret;
+            }
+            template <detail::deduce..., typename Void = void, std::enable_if_t<detail::dependent_value<Void, is_homogeneous && is_lvalue_only>::value, detail::nullptr_t> = nullptr>
+            detail::elem_iter<homogeneous_type> end() const & noexcept
+            {
+                detail::elem_iter<homogeneous_type> ret;
+                ret.ptr = elems.values + sizeof...(P);
+                return ret;
+            }
+            // Non-lvalue-only.
+            template <detail::deduce..., typename Void = void, std::enable_if_t<detail::dependent_value<Void, is_homogeneous && !is_lvalue_only>::value, detail::nullptr_t> = nullptr>
+            detail::elem_iter<homogeneous_type> begin() const && noexcept
+            {
+                detail::elem_iter<homogeneous_type> ret;
+                ret.ptr = elems.values;
+                return ret;
+            }
+            template <detail::deduce..., typename Void = void, std::enable_if_t<detail::dependent_value<Void, is_homogeneous && !is_lvalue_only>::value, detail::nullptr_t> = nullptr>
+            detail::elem_iter<homogeneous_type> end() const && noexcept
+            {
+                detail::elem_iter<homogeneous_type> ret;
+                ret.ptr = elems.values + sizeof...(P);
+                return ret;
+            }
+            // The number of elements. This makes lvalue-only homogeneous lists model `std::ranges::sized_range` directly, without subtracting the iterators.
+            template <detail::deduce..., typename Void = void, std::enable_if_t<detail::dependent_value<Void, is_homogeneous>::value, detail::nullptr_t> = nullptr>
+            BETTERLISTINIT_NODISCARD constexpr detail::size_t size() const noexcept
+            {
+                return sizeof...(P);
+            }
+
+            // Compile-time element access, for all lists (including heterogeneous ones).
+            // Unlike the conversions, this doesn't involve any type erasure, and should compile to direct accesses.
+            // This also enables structured bindings: `auto [a, b] = init{x, y};`.
+
+            // Lvalue-only.
+            // Returns the `I`th element, forwarded.
+            template <detail::size_t I, detail::deduce..., typename Void = void, std::enable_if_t<detail::dependent_value<Void, is_lvalue_only>::value, detail::nullptr_t> = nullptr>
+            BETTERLISTINIT_NODISCARD constexpr detail::nth_type<I, P &&...> get() const & noexcept
+            {
+                return elems.template elem<I>();
+            }
+            // Calls `func` with all elements at once, forwarded. Returns the result.
+            template <typename F, std::enable_if_t<detail::dependent_value<F, is_lvalue_only>::value, detail::nullptr_t> = nullptr>
+            constexpr decltype(auto) apply(F &&func) const &
+            {
+                return elems.apply(static_cast<F &&>(func));
+            }
+            // Calls `func` with each element in order, forwarded.
+            template <typename F, std::enable_if_t<detail::dependent_value<F, is_lvalue_only>::value, detail::nullptr_t> = nullptr>
+            constexpr void for_each(F &&func) const &
+            {
+                elems.apply(detail::for_each_functor<F>{static_cast<F &&>(func)});
+            }
+            // Non-lvalue-only.
+            template <detail::size_t I, detail::deduce..., typename Void = void, std::enable_if_t<detail::dependent_value<Void, !is_lvalue_only>::value, detail::nullptr_t> = nullptr>
+            BETTERLISTINIT_NODISCARD constexpr detail::nth_type<I, P &&...> get() const && noexcept
+            {
+                return elems.template elem<I>();
+            }
+            template <typename F, std::enable_if_t<detail::dependent_value<F, !is_lvalue_only>::value, detail::nullptr_t> = nullptr>
+            constexpr decltype(auto) apply(F &&func) const &&
+            {
+                return elems.apply(static_cast<F &&>(func));
+            }
+            template <typename F, std::enable_if_t<detail::dependent_value<F, !is_lvalue_only>::value, detail::nullptr_t> = nullptr>
+            constexpr void for_each(F &&func) const &&
+            {
+                elems.apply(detail::for_each_functor<F>{static_cast<F &&>(func)});
+            }
 
-            // See the public `_helper`-less versions below.
-            // Note that we have to use a specialization here. Directly inheriting from `integral_constant` isn't enough, because it's not SFINAE-friendly (with respect to the `element_type<T>::type`).
-            template <typename Void, typename T, typename ...Q> struct can_initialize_range_helper : std::false_type {};
-            template <typename T, typename ...Q> struct can_initialize_range_helper        <std::enable_if_t<custom::is_range<T>::value && detail::constructible_from_iters        <T, elem_iter<typename custom::element_type<T>::type>, BETTERLISTINIT_IDENTIFIER, Q...>::value && can_initialize_elem        <typename custom::element_type<T>::type>::value>, T, Q...> : std::true_type {};
-            template <typename Void, typename T, typename ...Q> struct can_nothrow_initialize_range_helper : std::false_type {};
-            template <typename T, typename ...Q> struct can_nothrow_initialize_range_helper<std::enable_if_t<custom::is_range<T>::value && detail::nothrow_constructible_from_iters<T, elem_iter<typename custom::element_type<T>::type>, BETTERLISTINIT_IDENTIFIER, Q...>::value && can_nothrow_initialize_elem<typename custom::element_type<T>::type>::value>, T, Q...> : std::true_type {};
+          private:
+            // Whether `.as<R>()` is allowed.
+            // Without the mandatory copy elision, we can't return non-copyable lists, so `R` must be an lvalue reference.
+            // The elements must bind to `R` directly. Conversions that create temporaries (e.g. `int` to `const long &`) would leave dangling references.
+            template <typename R>
+            struct can_view_as : detail::all_of_flat<
+                std::is_reference<R>,
+                std::integral_constant<bool, sizeof...(P) != 0 && (BETTERLISTINIT_CXX_STANDARD >= 17 || std::is_lvalue_reference<R>::value)>,
+                std::is_convertible<P &&, R>...,
+                std::is_convertible<std::remove_reference_t<P> *, std::remove_reference_t<R> *>...
+            > {};
 
           public:
-            // Whether this list can be used to initialize a range type `T`, with extra constructor arguments `Q...`.
-            template <typename T, typename ...Q> struct can_initialize_range         : can_initialize_range_helper        <void, T, Q...> {};
-            template <typename T, typename ...Q> struct can_nothrow_initialize_range : can_nothrow_initialize_range_helper<void, T, Q...> {};
-            // Whether this list can be used to initialize a non-range of type `T` (by forwarding arguments to the constructor), with extra constructor arguments `Q...`.
-            // NOTE: We check `!is_range<T>` here to avoid the uniform init fiasco, at least for our lists.
-            // NOTE: We need short-circuiting here, otherwise libstdc++ 10 in C++14 mode fails with a hard error in `nonrange_brace_constructible`.
-            // NOTE: `sizeof...(Q) == 0` is an arbitrary restriction, hopefully forcing a more clear usage.
-            template <typename T, typename ...Q> struct can_initialize_nonrange         : detail::all_of<detail::negate<custom::is_range<T>>, std::integral_constant<bool, sizeof...(Q) == 0>, detail::nonrange_brace_constructible        <T, BETTERLISTINIT_IDENTIFIER, P..., Q...>> {};
-            template <typename T, typename ...Q> struct can_nothrow_initialize_nonrange : detail::all_of<detail::negate<custom::is_range<T>>, std::integral_constant<bool, sizeof...(Q) == 0>, detail::nothrow_nonrange_brace_constructible<T, BETTERLISTINIT_IDENTIFIER, P..., Q...>> {};
+            // Returns a homogeneous list of `R`s, referring to the same elements. Then you can iterate over it with `.begin()`/`.end()`.
+            // `R` must be a reference, and all elements must bind to it without temporaries. E.g. `for (Base &elem : init{a, derived, c}.as<Base &>())`.
+            // Defaults to `std::common_reference_t<P &&...>` in C++20, if that is a reference.
+            // The resulting list stores plain pointers to the converted references, so iterating over it involves no indirect calls.
+            // If `R` is an rvalue reference, the resulting list has `&&`-qualified `.begin()`/`.end()` like any other list with rvalues,
+            //   so it can't be used in a range-for loop (the range is always an lvalue there). Use `std::move(list).begin()` and `std::move(list).end()`.
 
-          private:
-            template <typename T>
-            struct convert_functor
+            // Lvalue-only.
+            template <typename R = detail::use_common_reference, typename RR = typename detail::resolve_common_reference<R, P &&...>::type, std::enable_if_t<can_view_as<RR>::value && is_lvalue_only, detail::nullptr_t> = nullptr>
+            BETTERLISTINIT_NODISCARD constexpr detail::repeat_type<BETTERLISTINIT_IDENTIFIER, RR, sizeof...(P)> as() const & noexcept
             {
-                const BETTERLISTINIT_IDENTIFIER *list = nullptr;
+                return elems.apply(detail::cast_elems_functor<RR, detail::repeat_type<BETTERLISTINIT_IDENTIFIER, RR, sizeof...(P)>>{});
+            }
+            // Non-lvalue-only.
+            template <typename R = detail::use_common_reference, typename RR = typename detail::resolve_common_reference<R, P &&...>::type, std::enable_if_t<can_view_as<RR>::value && !is_lvalue_only, detail::nullptr_t> = nullptr>
+            BETTERLISTINIT_NODISCARD constexpr detail::repeat_type<BETTERLISTINIT_IDENTIFIER, RR, sizeof...(P)> as() const && noexcept
+            {
+                return elems.apply(detail::cast_elems_functor<RR, detail::repeat_type<BETTERLISTINIT_IDENTIFIER, RR, sizeof...(P)>>{});
+            }
 
-                // Convert to an empty range.
-                template <typename ...Q, std::enable_if_t<can_initialize_range<T, Q...>::value && sizeof...(P) == 0, detail::nullptr_t> = nullptr>
-                BETTERLISTINIT_NODISCARD constexpr T operator()(Q &&... extra_args) const
+            #if BETTERLISTINIT_CXX_STANDARD >= 17
+          private:
+            // The state needed by `range_view<E>` to iterate over the list, depending on the list kind.
+            // 0 = empty, 1 = homogeneous, 2 = heterogeneous, 3 = with spliced ranges, 4 = character arrays, 5 = normalized elements.
+            template <typename E, int Kind = sizeof...(P) == 0 ? 0 : uses_char_array_refs<E>::value ? 4 : uses_normalized_elems<E>::value ? 5 : is_homogeneous ? 1 : has_spread_elems ? 3 : 2>
+            struct range_storage
+            {
+                BETTERLISTINIT_FORCEINLINE constexpr detail::size_t bind(const BETTERLISTINIT_IDENTIFIER &, iterator_t<E> &, iterator_t<E> &) noexcept
                 {
-                    using elem_type = typename custom::element_type<T>::type;
-                    return custom::construct_range<void, T, elem_iter<elem_type>, BETTERLISTINIT_IDENTIFIER, Q...>{}(elem_iter<elem_type>{}, elem_iter<elem_type>{}, static_cast<Q &&>(extra_args)...);
+                    return 0;
                 }
-                // Convert to a non-empty heterogeneous range.
-                template <typename ...Q, std::enable_if_t<can_initialize_range<T, Q...>::value && sizeof...(P) != 0 && !is_homogeneous, detail::nullptr_t> = nullptr>
-                BETTERLISTINIT_NODISCARD constexpr T operator()(Q &&... extra_args) const
+            };
+            // Homogeneous lists iterate over the elements directly.
+            template <typename E>
+            struct range_storage<E, 1>
+            {
+                BETTERLISTINIT_FORCEINLINE constexpr detail::size_t bind(const BETTERLISTINIT_IDENTIFIER &list, iterator_t<E> &begin, iterator_t<E> &end) noexcept
                 {
-                    using elem_type = typename custom::element_type<T>::type;
-
-                    // Must store `elem_ref`s here, because `std::random_access_iterator` requires `operator[]` to return the same type as `operator*`,
-                    // and `LegacyForwardIterator` requires `operator*` to return an actual reference. If we don't have those here, we don't have anything for the references to point to.
-                    typename elem_ref<elem_type>::template array<sizeof...(P)> refs;
-                    for (detail::size_t i = 0; i < sizeof...(P); i++)
-                    {
-                        refs.elems[i].target = &list->elems;
-                        refs.elems[i].index = i;
-                    }
+                    begin.ptr = list.elems.values;
+                    end.ptr = list.elems.values + sizeof...(P);
+                    return sizeof...(P);
+                }
+            };
+            // Heterogeneous lists iterate over the element references, like when converting to a range.
+            template <typename E>
+            struct range_storage<E, 2>
+            {
+                typename iterator_t<E>::value_type::template array<sizeof...(P)> refs;
 
-                    elem_iter<elem_type> begin, end;
+                BETTERLISTINIT_FORCEINLINE constexpr detail::size_t bind(const BETTERLISTINIT_IDENTIFIER &list, iterator_t<E> &begin, iterator_t<E> &end) noexcept
+                {
+                    detail::size_t size = bind_elem_refs(list, refs.elems);
                     begin.ptr = refs.elems;
-                    end.ptr = refs.elems + sizeof...(P);
-
-                    return custom::construct_range<void, T, elem_iter<elem_type>, BETTERLISTINIT_IDENTIFIER, Q...>{}(begin, end, static_cast<Q &&>(extra_args)...);
+                    end.ptr = refs.elems + size;
+                    return size;
                 }
-                // Convert to a non-empty homogeneous range.
-                template <typename ...Q, std::enable_if_t<can_initialize_range<T, Q...>::value && sizeof...(P) != 0 && is_homogeneous, detail::nullptr_t> = nullptr>
-                BETTERLISTINIT_NODISCARD constexpr T operator()(Q &&... extra_args) const
-                {
-                    using elem_type = typename custom::element_type<T>::type;
-
-                    elem_iter<elem_type> begin, end;
-                    begin.ptr = list->elems.values;
-                    end.ptr = list->elems.values + sizeof...(P);
+            };
+            // Lists with spliced ranges store the element boundaries.
+            template <typename E>
+            struct range_storage<E, 3>
+            {
+                detail::size_t ends[sizeof...(P) + 1]{};
+                detail::no_transform transform;
 
-                    return custom::construct_range<void, T, elem_iter<elem_type>, BETTERLISTINIT_IDENTIFIER, Q...>{}(begin, end, static_cast<Q &&>(extra_args)...);
+                BETTERLISTINIT_FORCEINLINE constexpr detail::size_t bind(const BETTERLISTINIT_IDENTIFIER &list, iterator_t<E> &begin, iterator_t<E> &end)
+                {
+                    return bind_proxy_iters(list, transform, ends, begin, end);
                 }
-                // Convert to a non-range.
-                template <typename ...Q, std::enable_if_t<can_initialize_nonrange<T, Q...>::value, detail::nullptr_t> = nullptr>
-                BETTERLISTINIT_NODISCARD constexpr T operator()(Q &&... extra_args) const
+            };
+            // Lists of character arrays store the pointers and the lengths.
+            template <typename E>
+            struct range_storage<E, 4>
+            {
+                typename iterator_t<E>::value_type refs[sizeof...(P)];
+
+                BETTERLISTINIT_FORCEINLINE constexpr detail::size_t bind(const BETTERLISTINIT_IDENTIFIER &list, iterator_t<E> &begin, iterator_t<E> &end) noexcept
                 {
-                    detail::tuple<Q &&...> extra_tuple{&extra_args...};
-                    using func_t = custom::construct_nonrange<void, T, BETTERLISTINIT_IDENTIFIER, P..., Q...>;
-                    return extra_tuple.apply(detail::apply_functor<func_t, const tuple_t &>{func_t{}, list->elems});
+                    detail::size_t size = bind_char_array_refs(list, refs);
+                    begin.ptr = refs;
+                    end.ptr = refs + size;
+                    return size;
                 }
             };
+            // Lists with normalized elements store the pointers to them, and possibly the converted elements.
+            template <typename E>
+            struct range_storage<E, 5> : normalized_storage<E> {};
+
+            // This is returned by `.range<E>()`. A sized random-access range of `E`s (or of references convertible to `E`), referring to the list elements.
+            // It's not copyable nor movable, because it may store the element references that the iterators point to.
+            template <typename E>
+            class range_view
+            {
+                friend BETTERLISTINIT_IDENTIFIER;
+                range_storage<E> storage;
+                iterator_t<E> first, last;
+                detail::size_t count = 0;
 
-            template <typename Void, typename T, typename ...Q> struct can_nothrow_initialize_helper : can_nothrow_initialize_nonrange<T, Q...> {};
-            template <typename T, typename ...Q> struct can_nothrow_initialize_helper<std::enable_if_t<custom::is_range<T>::value>, T, Q...> : can_nothrow_initialize_range<T, Q...> {};
+                constexpr range_view(const BETTERLISTINIT_IDENTIFIER &list) : count(storage.bind(list, first, last)) {}
 
-            template <typename Void, typename T, typename ...Q>
-            struct allow_implicit_init_helper : custom::allow_implicit_nonrange_init<void, T, P..., Q...> {};
-            template <typename T, typename ...Q>
-            struct allow_implicit_init_helper<std::enable_if_t<custom::is_range<T>::value>, T, Q...> : custom::allow_implicit_range_init<void, T, Q.../*note, no P...*/> {};
+              public:
+                range_view(const range_view &) = delete;
+                range_view &operator=(const range_view &) = delete;
+
+                BETTERLISTINIT_NODISCARD constexpr iterator_t<E> begin() const noexcept {return first;}
+                BETTERLISTINIT_NODISCARD constexpr iterator_t<E> end() const noexcept {return last;}
+                BETTERLISTINIT_NODISCARD constexpr detail::size_t size() const noexcept {return count;}
+                BETTERLISTINIT_NODISCARD constexpr bool empty() const noexcept {return count == 0;}
+            };
 
           public:
-            // Whether this list can be used to initialize a type `T`, with extra constructor arguments `Q...`.
-            // Returns true if `can_initialize_range<T,Q...>` or `can_initialize_nonrange<T,Q...>` is true.
-            template <typename T, typename ...Q> struct can_initialize : detail::any_of<can_initialize_range<T, Q...>, can_initialize_nonrange<T, Q...>> {};
-            template <typename T, typename ...Q> struct can_nothrow_initialize : can_nothrow_initialize_helper<void, T, Q...> {};
+            // Returns a range of `E`s referring to the list elements, for the APIs that accept ranges,
+            // e.g. `vec.append_range(init{a, b, c}.range<T>())` or `std::ranges::to<std::vector<T>>(init{a, b, c}.range<T>())`.
+            // The range is sized and random-access, so the containers can allocate once. It uses the same iterators as the conversions to ranges.
+            // `E` defaults to the homogeneous type without cv-ref-qualifiers. Heterogeneous lists must specify it.
+            // Requires C++17, since the result is neither copyable nor movable.
 
-            // Whether the conversion to `T` should be implicit, for extra constructor arguments `Q...`.
-            template <typename T, typename ...Q>
-            struct allow_implicit_init : allow_implicit_init_helper<void, T, Q...> {};
+            // Lvalue-only.
+            template <typename E = std::remove_cv_t<std::remove_reference_t<homogeneous_type>>, detail::enable_if_valid_conversion_target<E> = 0, std::enable_if_t<can_initialize_elem<E>::value && is_lvalue_only, detail::nullptr_t> = nullptr>
+            BETTERLISTINIT_NODISCARD constexpr range_view<E> range() const &
+            {
+                return range_view<E>(*this);
+            }
+            // Non-lvalue-only.
+            template <typename E = std::remove_cv_t<std::remove_reference_t<homogeneous_type>>, detail::enable_if_valid_conversion_target<E> = 0, std::enable_if_t<can_initialize_elem<E>::value && !is_lvalue_only, detail::nullptr_t> = nullptr>
+            BETTERLISTINIT_NODISCARD constexpr range_view<E> range() const &&
+            {
+                return range_view<E>(*this);
+            }
+            #endif
+        };
 
-            // The constructor from a braced (or parenthesized) list.
-            // No `[[nodiscard]]` because GCC 9 complains. Having it on the entire class should be enough.
-            constexpr BETTERLISTINIT_IDENTIFIER(P &&... params) noexcept
-                : elems{&params...}
-            {}
+        #if BETTERLISTINIT_ALLOW_BRACES
+        template <typename ...P>
+        BETTERLISTINIT_IDENTIFIER(P &&...) -> BETTERLISTINIT_IDENTIFIER<P...>;
+        #endif
 
-            // Only copyable if `is_lvalue_only` is true.
 
-            // The conversion functions below are `&&`-qualified as a reminder that your initializer elements can be dangling,
-            // unless the list only contains lvalues.
+        // An owning counterpart of `init{...}`, which stores the elements by value.
+        // Unlike `init{...}`, it can be converted to containers any number of times, without re-evaluating the element expressions.
+        // Converting an lvalue copies the elements, and converting an rvalue moves them.
+        // To use non-copyable elements, wrap them in `factory(...)`, see below.
+        template <typename ...P>
+        class BETTERLISTINIT_NODISCARD prototype
+        {
+            detail::value_tuple<P...> elems;
 
-            // Conversion operators.
-            // Those work with both ranges (constructible from a pair of iterators) and non-ranges (constructible from braced lists).
-            // Note that non-ranges can't use `(...)`, because `std::array` is a non-range and we want to support it too (including pre-C++20).
-            // Note that the uniform init fiasco is impossible for our lists, since we allow braced init only if `detail::is_range<T>` is false.
+            // The lists we create when converting lvalues and rvalues respectively.
+            using copy_list_t = BETTERLISTINIT_IDENTIFIER<const P &...>;
+            using move_list_t = BETTERLISTINIT_IDENTIFIER<P...>;
 
-            // Implicit, lvalue-only lists.
-            template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<can_initialize<T>::value && allow_implicit_init<T>::value && is_lvalue_only, detail::nullptr_t> = nullptr>
-            BETTERLISTINIT_NODISCARD constexpr operator T() const & noexcept(can_nothrow_initialize<T>::value)
+            template <typename T, detail::size_t ...I>
+            constexpr T convert_copy(detail::index_sequence<I...>) const
             {
-                return convert_functor<T>{this}();
+                return copy_list_t(elems.template get<I>()...).operator T();
             }
-            // Explicit, lvalue-only lists.
-            template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<can_initialize<T>::value && !allow_implicit_init<T>::value && is_lvalue_only, detail::nullptr_t> = nullptr>
-            BETTERLISTINIT_NODISCARD constexpr explicit operator T() const & noexcept(can_nothrow_initialize<T>::value)
+            template <typename T, detail::size_t ...I>
+            constexpr T convert_move(detail::index_sequence<I...>)
             {
-                return convert_functor<T>{this}();
+                return move_list_t(static_cast<P &&>(elems.template get<I>())...).operator T();
             }
-            // Implicit, non-lvalue-only lists.
-            template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<can_initialize<T>::value && allow_implicit_init<T>::value && !is_lvalue_only, detail::nullptr_t> = nullptr>
-            BETTERLISTINIT_NODISCARD constexpr operator T() const && noexcept(can_nothrow_initialize<T>::value)
+
+            template <detail::size_t ...I>
+            constexpr copy_list_t make_copy_list(detail::index_sequence<I...>) const noexcept
             {
-                return convert_functor<T>{this}();
+                return {elems.template get<I>()...};
             }
-            // Explicit, non-lvalue-only lists.
-            template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<can_initialize<T>::value && !allow_implicit_init<T>::value && !is_lvalue_only, detail::nullptr_t> = nullptr>
-            BETTERLISTINIT_NODISCARD constexpr explicit operator T() const && noexcept(can_nothrow_initialize<T>::value)
+            #if BETTERLISTINIT_CXX_STANDARD >= 17
+            template <detail::size_t ...I>
+            constexpr move_list_t make_move_list(detail::index_sequence<I...>) noexcept
             {
-                return convert_functor<T>{this}();
+                return {static_cast<P &&>(elems.template get<I>())...};
             }
+            #endif
 
-          private:
-            // This is used to convert to ranges with extra constructor arguments.
-            template <typename ...Q>
-            class conversion_helper
-            {
-                friend BETTERLISTINIT_IDENTIFIER;
-                const BETTERLISTINIT_IDENTIFIER *list = nullptr;
-                detail::tuple<Q &&...> extra_params;
-
-                constexpr conversion_helper(const BETTERLISTINIT_IDENTIFIER *list, detail::tuple<Q &&...> extra_params)
-                    : list(list), extra_params(extra_params)
-                {}
+          public:
+            template <typename ...Q, std::enable_if_t<detail::pairwise_constructible<detail::type_list<P...>, detail::type_list<Q &&...>>::value, detail::nullptr_t> = nullptr>
+            constexpr prototype(Q &&... params)
+                : elems(detail::from_values_tag{}, static_cast<Q &&>(params)...)
+            {}
 
-              public:
-                // Implicit, lvalue-only lists.
-                template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<can_initialize<T, Q...>::value && allow_implicit_init<T, Q...>::value && is_lvalue_only, detail::nullptr_t> = nullptr>
-                BETTERLISTINIT_NODISCARD constexpr operator T() const & noexcept(can_nothrow_initialize<T, Q...>::value)
-                {
-                    return extra_params.apply(convert_functor<T>{list});
-                }
-                // Explicit, lvalue-only lists.
-                template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<can_initialize<T, Q...>::value && !allow_implicit_init<T, Q...>::value && is_lvalue_only, detail::nullptr_t> = nullptr>
-                BETTERLISTINIT_NODISCARD constexpr explicit operator T() const & noexcept(can_nothrow_initialize<T, Q...>::value)
-                {
-                    return extra_params.apply(convert_functor<T>{list});
-                }
-                // Implicit, non-lvalue-only lists.
-                template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<can_initialize<T, Q...>::value && allow_implicit_init<T, Q...>::value && !is_lvalue_only, detail::nullptr_t> = nullptr>
-                BETTERLISTINIT_NODISCARD constexpr operator T() const && noexcept(can_nothrow_initialize<T, Q...>::value)
-                {
-                    return extra_params.apply(convert_functor<T>{list});
-                }
-                // Explicit, non-lvalue-only lists.
-                template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<can_initialize<T, Q...>::value && !allow_implicit_init<T, Q...>::value && !is_lvalue_only, detail::nullptr_t> = nullptr>
-                BETTERLISTINIT_NODISCARD constexpr explicit operator T() const && noexcept(can_nothrow_initialize<T, Q...>::value)
-                {
-                    return extra_params.apply(convert_functor<T>{list});
-                }
-            };
+            // Conversion operators. Those mimic the ones in `init{...}`.
 
-          public:
-            // Returns a helper object with conversion operators.
-            // `extra_params...` are the extra parameters passed to the type's constructor, after the pair of iterators.
-            template <typename ...Q>
-            BETTERLISTINIT_NODISCARD constexpr conversion_helper<Q &&...> and_with(Q &&... extra_params) const && noexcept
+            // Implicit, copying.
+            template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<copy_list_t::template can_initialize<T>::value && copy_list_t::template allow_implicit_init<T>::value, detail::nullptr_t> = nullptr>
+            BETTERLISTINIT_NODISCARD constexpr operator T() const & noexcept(copy_list_t::template can_nothrow_initialize<T>::value)
             {
-                return {this, {&extra_params...}};
+                return convert_copy<T>(detail::make_index_sequence<sizeof...(P)>{});
             }
-
-            // Begin/end iterators, for homogeneous lists only.
-
-            // Lvalue-only.
-            template <detail::deduce..., typename Void = void, std::enable_if_t<detail::dependent_value<Void, is_homogeneous && is_lvalue_only>::value, detail::nullptr_t> = nullptr>
-            elem_iter<Void> begin() const & noexcept
+            // Explicit, copying.
+            template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<copy_list_t::template can_initialize<T>::value && !copy_list_t::template allow_implicit_init<T>::value, detail::nullptr_t> = nullptr>
+            BETTERLISTINIT_NODISCARD constexpr explicit operator T() const & noexcept(copy_list_t::template can_nothrow_initialize<T>::value)
             {
-                elem_iter<Void> ret;
-                ret.ptr = elems.values;
-                return ret;
+                return convert_copy<T>(detail::make_index_sequence<sizeof...(P)>{});
             }
-            template <detail::deduce..., typename Void = void, std::enable_if_t<detail::dependent_value<Void, is_homogeneous && is_lvalue_only>::value, detail::nullptr_t> = nullptr>
-            elem_iter<Void> end() const & noexcept
+            // Implicit, moving.
+            template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<move_list_t::template can_initialize<T>::value && move_list_t::template allow_implicit_init<T>::value, detail::nullptr_t> = nullptr>
+            BETTERLISTINIT_NODISCARD constexpr operator T() && noexcept(move_list_t::template can_nothrow_initialize<T>::value)
             {
-                elem_iter<Void> ret;
-                ret.ptr = elems.values + sizeof...(P);
-                return ret;
+                return convert_move<T>(detail::make_index_sequence<sizeof...(P)>{});
             }
-            // Non-lvalue-only.
-            template <detail::deduce..., typename Void = void, std::enable_if_t<detail::dependent_value<Void, is_homogeneous && !is_lvalue_only>::value, detail::nullptr_t> = nullptr>
-            elem_iter<Void> begin() const && noexcept
+            // Explicit, moving.
+            template <typename T, detail::enable_if_valid_conversion_target<T> = 0, std::enable_if_t<move_list_t::template can_initialize<T>::value && !move_list_t::template allow_implicit_init<T>::value, detail::nullptr_t> = nullptr>
+            BETTERLISTINIT_NODISCARD constexpr explicit operator T() && noexcept(move_list_t::template can_nothrow_initialize<T>::value)
             {
-                elem_iter<Void> ret;
-                ret.ptr = elems.values;
-                return ret;
+                return convert_move<T>(detail::make_index_sequence<sizeof...(P)>{});
             }
-            template <detail::deduce..., typename Void = void, std::enable_if_t<detail::dependent_value<Void, is_homogeneous && !is_lvalue_only>::value, detail::nullptr_t> = nullptr>
-            elem_iter<Void> end() const && noexcept
+
+            // Returns an `init{...}` list referring to the stored elements. Use this to access the rest of its interface, e.g. `.and_with(...)`.
+            // The lvalue overload lets you copy the elements, and the rvalue one lets you move them.
+            BETTERLISTINIT_NODISCARD constexpr copy_list_t list() const & noexcept
             {
-                elem_iter<Void> ret;
-                ret.ptr = elems.values + sizeof...(P);
-                return ret;
+                return make_copy_list(detail::make_index_sequence<sizeof...(P)>{});
             }
+            // Without the mandatory copy elision, we can't return non-copyable lists.
+            #if BETTERLISTINIT_CXX_STANDARD >= 17
+            BETTERLISTINIT_NODISCARD constexpr move_list_t list() && noexcept
+            {
+                return make_move_list(detail::make_index_sequence<sizeof...(P)>{});
+            }
+            #endif
         };
 
         #if BETTERLISTINIT_ALLOW_BRACES
         template <typename ...P>
-        BETTERLISTINIT_IDENTIFIER(P &&...) -> BETTERLISTINIT_IDENTIFIER<P...>;
+        prototype(P &&...) -> prototype<std::decay_t<P>...>;
+        #endif
+
+        // An optional list element: `init{a, when(cond, b), c}` contains `b` only if `cond` is true.
+        // Lists with such elements can only initialize ranges. The disabled elements are skipped before the container is constructed,
+        // so it still receives a pair of random-access iterators with the exact size.
+        // Like `init{...}`, this only stores a reference to the element, and is only copyable if it's an lvalue.
+        template <typename T>
+        class BETTERLISTINIT_NODISCARD when : detail::maybe_copyable<std::is_lvalue_reference<T>::value>
+        {
+            std::remove_reference_t<T> *target = nullptr;
+            bool condition = false;
+
+          public:
+            constexpr when(bool condition, T &&value) noexcept
+                : target(&value), condition(condition)
+            {}
+
+            // Whether the element is included in the list.
+            BETTERLISTINIT_NODISCARD constexpr bool enabled() const noexcept {return condition;}
+            // Returns the element, forwarded.
+            BETTERLISTINIT_NODISCARD constexpr T &&value() const noexcept {return static_cast<T &&>(*target);}
+        };
+
+        #if BETTERLISTINIT_ALLOW_BRACES
+        template <typename T>
+        when(bool, T &&) -> when<T>;
         #endif
+
+        // Splices a range into a list: `init{a, spread(range), b}` contains `a`, then all elements of `range`, then `b`.
+        // The range must have random-access iterators (or be an array). The elements are moved from rvalue ranges, and copied from lvalue ones.
+        // Lists with spliced ranges can only initialize ranges. The total size is computed before the container is constructed, so it can allocate once.
+        // Like `init{...}`, this only stores a reference to the range, and is only copyable if it's an lvalue.
+        template <typename R>
+        class BETTERLISTINIT_NODISCARD spread : detail::maybe_copyable<std::is_lvalue_reference<R>::value>
+        {
+            static_assert(detail::is_spreadable<R>::value, "`spread(...)` requires a range with random-access iterators.");
+
+            std::remove_reference_t<R> *target = nullptr;
+
+          public:
+            constexpr spread(R &&range) noexcept
+                : target(&range)
+            {}
+
+            // Returns the range, forwarded.
+            BETTERLISTINIT_NODISCARD constexpr R &&range() const noexcept {return static_cast<R &&>(*target);}
+        };
+
+        #if BETTERLISTINIT_ALLOW_BRACES
+        template <typename R>
+        spread(R &&) -> spread<R>;
+        #endif
+
+        // Generates list elements by calling a function: `init{a, generate(n, func)}` contains `a`, then `func(0)`, ..., `func(n-1)`.
+        // If `func` returns the target element type by value, the elements are constructed in place (in C++17 and newer), so they don't need to be movable.
+        // This gives ranges with a runtime size of non-movable elements, e.g. `std::vector<std::mutex>`, or elements that need per-index constructor arguments.
+        // Like `spread(range)`, this can only initialize ranges. Like `init{...}`, this only stores a reference to the function, and is only copyable if it's an lvalue.
+        template <typename F>
+        class BETTERLISTINIT_NODISCARD generate : detail::maybe_copyable<std::is_lvalue_reference<F>::value>
+        {
+            std::remove_reference_t<F> *target = nullptr;
+            detail::size_t count = 0;
+
+          public:
+            constexpr generate(detail::size_t count, F &&func) noexcept
+                : target(&func), count(count)
+            {}
+
+            // The number of elements.
+            BETTERLISTINIT_NODISCARD constexpr detail::size_t size() const noexcept {return count;}
+            // Returns the function. It's called once per element, so it's always an lvalue.
+            BETTERLISTINIT_NODISCARD constexpr std::remove_reference_t<F> &func() const noexcept {return *target;}
+        };
+
+        #if BETTERLISTINIT_ALLOW_BRACES
+        template <typename F>
+        generate(detail::size_t, F &&) -> generate<F>;
+        #endif
+
+        // Repeats a list element: `init{a, repeat(n, b)}` contains `a`, then `n` copies of `b`.
+        // Each element is constructed directly from `b`, e.g. `std::vector<std::atomic_int> vec = init{repeat(n, 0)};` works.
+        // Like `spread(range)`, this can only initialize ranges. Like `init{...}`, this only stores a reference to the value, and is only copyable if it's an lvalue.
+        template <typename T>
+        class BETTERLISTINIT_NODISCARD repeat : detail::maybe_copyable<std::is_lvalue_reference<T>::value>
+        {
+            std::remove_reference_t<T> *target = nullptr;
+            detail::size_t count = 0;
+
+          public:
+            constexpr repeat(detail::size_t count, T &&value) noexcept
+                : target(&value), count(count)
+            {}
+
+            // The number of elements.
+            BETTERLISTINIT_NODISCARD constexpr detail::size_t size() const noexcept {return count;}
+            // Returns the value. It's used several times, so it's always a const lvalue.
+            BETTERLISTINIT_NODISCARD constexpr const std::remove_reference_t<T> &value() const noexcept {return *target;}
+        };
+
+        #if BETTERLISTINIT_ALLOW_BRACES
+        template <typename T>
+        repeat(detail::size_t, T &&) -> repeat<T>;
+        #endif
+
+        // Wraps a function. When used as an element of a `prototype`, it calls the function each time the element needs to be constructed.
+        // E.g. `prototype{factory([]{return std::make_unique<int>(42);})}`.
+        template <typename F>
+        class factory
+        {
+            F func;
+
+          public:
+            using result_type = decltype(detail::declval<const F &>()());
+
+            constexpr factory(F func) : func(static_cast<F &&>(func)) {}
+
+            constexpr operator result_type() const noexcept(noexcept(detail::declval<const F &>()()))
+            {
+                return func();
+            }
+        };
     }
 
     #if BETTERLISTINIT_ALLOW_BRACES
@@ -1156,12 +4689,62 @@ namespace better_list_init
     #else
     // A helper function to construct the list class.
     template <typename ...P>
-    BETTERLISTINIT_NODISCARD constexpr type::BETTERLISTINIT_IDENTIFIER<P...> BETTERLISTINIT_IDENTIFIER(P &&... params) noexcept
+    BETTERLISTINIT_NODISCARD BETTERLISTINIT_FORCEINLINE constexpr type::BETTERLISTINIT_IDENTIFIER<P...> BETTERLISTINIT_IDENTIFIER(P &&... params) noexcept
     {
         // Note, not doing `return T(...);`. There's difference in C++14, when there's no mandatory copy elision.
         return {static_cast<P &&>(params)...};
     }
     #endif
+
+    #if BETTERLISTINIT_ALLOW_BRACES
+    using type::prototype;
+    using type::factory;
+    using type::when;
+    using type::spread;
+    using type::generate;
+    using type::repeat;
+    #else
+    // Helper functions to construct `type::prototype`, `type::factory`, `type::when`, `type::spread`, `type::generate`, and `type::repeat`.
+    template <typename ...P>
+    BETTERLISTINIT_NODISCARD constexpr type::prototype<std::decay_t<P>...> prototype(P &&... params)
+    {
+        return {static_cast<P &&>(params)...};
+    }
+    template <typename F>
+    BETTERLISTINIT_NODISCARD constexpr type::factory<std::decay_t<F>> factory(F &&func)
+    {
+        return {static_cast<F &&>(func)};
+    }
+    template <typename T>
+    BETTERLISTINIT_NODISCARD constexpr type::when<T> when(bool condition, T &&value) noexcept
+    {
+        return {condition, static_cast<T &&>(value)};
+    }
+    template <typename R>
+    BETTERLISTINIT_NODISCARD constexpr type::spread<R> spread(R &&range) noexcept
+    {
+        return {static_cast<R &&>(range)};
+    }
+    template <typename F>
+    BETTERLISTINIT_NODISCARD constexpr type::generate<F> generate(detail::size_t count, F &&func) noexcept
+    {
+        return {count, static_cast<F &&>(func)};
+    }
+    template <typename T>
+    BETTERLISTINIT_NODISCARD constexpr type::repeat<T> repeat(detail::size_t count, T &&value) noexcept
+    {
+        return {count, static_cast<T &&>(value)};
+    }
+    #endif
+}
+
+// Structured bindings support.
+namespace std
+{
+    template <typename ...P>
+    struct tuple_size<::better_list_init::type::BETTERLISTINIT_IDENTIFIER<P...>> : integral_constant<::better_list_init::detail::size_t, sizeof...(P)> {};
+    template <::better_list_init::detail::size_t I, typename ...P>
+    struct tuple_element<I, ::better_list_init::type::BETTERLISTINIT_IDENTIFIER<P...>> {using type = ::better_list_init::detail::nth_type<I, P &&...>;};
 }
 
 // The shorthand in the global namespace.
@@ -1367,10 +4950,10 @@ namespace better_list_init
         struct default_construct_range<
             std::enable_if_t<
                 detail::allocator_hack::enabled::value && // If the compile-time detection finds the `std::construct_at()` bug, and
-                (
-                    !List::is_homogeneous || // either the list is heterogeneous, or
-                    detail::allocator_hack::is_conversion_operator_init<typename custom::element_type<T>::type, typename List::homogeneous_type>::value // it's homogeneous, but the initialization uses `operator T`
-                ) && // and...
+                detail::any_of< // either the iterator returns our reference classes, or it returns the elements directly (homogeneous lists), but the initialization uses `operator T`
+                    detail::allocator_hack::is_elem_ref<decltype(*declval<Iter &>())>,
+                    detail::allocator_hack::is_conversion_operator_init<typename custom::element_type<T>::type, decltype(*declval<Iter &>())>
+                >::value && // and...
                 !std::is_move_constructible<typename custom::element_type<T>::type>::value && // if the type is not move-constructible, and
                 detail::allocator_hack::has_replaceable_allocator<T>::value // if there's an allocator we can replace.
             >,
@@ -57,6 +57,61 @@ namespace std _GLIBCXX_VISIBILITY(default)
 #endif
 
 
+// Test the optional parallel construction too.
+#ifndef BETTERLISTINIT_PARALLEL
+#define BETTERLISTINIT_PARALLEL 1
+#endif
+
+// And the `std::variant` support, if the standard is new enough.
+#ifndef BETTERLISTINIT_VARIANT
+#if (defined(_MSVC_LANG) ? _MSVC_LANG : __cplusplus) >= 201703
+#define BETTERLISTINIT_VARIANT 1
+#endif
+#endif
+
+// And the padded buffers.
+#ifndef BETTERLISTINIT_PADDED
+#define BETTERLISTINIT_PADDED 1
+#endif
+
+// And the polymorphic boxing.
+#ifndef BETTERLISTINIT_BOXED
+#define BETTERLISTINIT_BOXED 1
+#endif
+
+// And the shared arrays, if the standard is new enough.
+#ifndef BETTERLISTINIT_SHARED_ARRAY
+#if (defined(_MSVC_LANG) ? _MSVC_LANG : __cplusplus) >= 201703
+#define BETTERLISTINIT_SHARED_ARRAY 1
+#endif
+#endif
+
+// And the coroutines, if the standard is new enough.
+#ifndef BETTERLISTINIT_COROUTINES
+#if (defined(_MSVC_LANG) ? _MSVC_LANG : __cplusplus) >= 202002
+#define BETTERLISTINIT_COROUTINES 1
+#endif
+#endif
+
+// And the numeric types.
+#ifndef BETTERLISTINIT_NUMERIC
+#define BETTERLISTINIT_NUMERIC 1
+#endif
+
+// And the arenas, if the standard is new enough.
+#ifndef BETTERLISTINIT_ARENA
+#if (defined(_MSVC_LANG) ? _MSVC_LANG : __cplusplus) >= 201703
+#define BETTERLISTINIT_ARENA 1
+#endif
+#endif
+
+// And the tracing hooks, if the standard is new enough for them to not break `constexpr`.
+#ifndef BETTERLISTINIT_TRACE
+#if (defined(_MSVC_LANG) ? _MSVC_LANG : __cplusplus) >= 202002
+#define BETTERLISTINIT_TRACE 1
+#endif
+#endif
+
 #ifndef BETTERLISTINIT_CONFIG // This lets us run tests on godbolt easier, see below.
 #include "better_list_init.hpp"
 #endif
@@ -66,14 +121,40 @@ namespace std _GLIBCXX_VISIBILITY(default)
 #include <array>
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <iostream>
 #include <iterator>
 #include <map>
 #include <memory>
 #include <set>
+#include <string>
 #include <utility>
 #include <vector>
 
+#if BETTERLISTINIT_CXX_STANDARD >= 17
+#include <any>
+#endif
+#if BETTERLISTINIT_CXX_STANDARD >= 20
+#include <ranges>
+#endif
+#if BETTERLISTINIT_VARIANT
+#include <variant>
+#endif
+#if BETTERLISTINIT_NUMERIC
+#include <valarray>
+#endif
+#if BETTERLISTINIT_COROUTINES
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <latch>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <tuple>
+#endif
+
 
 // Expands to the preferred init list notation for the current language standard.
 #if BETTERLISTINIT_ALLOW_BRACES
@@ -123,12 +204,50 @@ namespace std _GLIBCXX_VISIBILITY(default)
     } \
     while (false)
 
+// Repeats the arguments the specified number of times, separated by commas. For testing long lists.
+#define REPEAT_10(...) __VA_ARGS__, __VA_ARGS__, __VA_ARGS__, __VA_ARGS__, __VA_ARGS__, __VA_ARGS__, __VA_ARGS__, __VA_ARGS__, __VA_ARGS__, __VA_ARGS__
+#define REPEAT_100(...) REPEAT_10(REPEAT_10(__VA_ARGS__))
+#define REPEAT_1000(...) REPEAT_10(REPEAT_100(__VA_ARGS__))
+#define REPEAT_10000(...) REPEAT_10(REPEAT_1000(__VA_ARGS__))
+
 // Tests if `T` has `.begin()` and `.end()`.
 template <typename T, typename = void>
 struct HasBeginEnd : std::false_type {};
 template <typename T>
 struct HasBeginEnd<T, decltype(void(std::declval<T>().begin()), void(std::declval<T>().end()))> : std::true_type {};
 
+// Tests if `T` has `.as<P...>()`.
+template <typename Void, typename T, typename ...P>
+struct HasAsHelper : std::false_type {};
+template <typename T, typename ...P>
+struct HasAsHelper<decltype(void(std::declval<T>().template as<P...>())), T, P...> : std::true_type {};
+template <typename T, typename ...P>
+struct HasAs : HasAsHelper<void, T, P...> {};
+
+// Tests if `T` has `.range<P...>()`.
+template <typename Void, typename T, typename ...P>
+struct HasRangeHelper : std::false_type {};
+template <typename T, typename ...P>
+struct HasRangeHelper<decltype(void(std::declval<T>().template range<P...>())), T, P...> : std::true_type {};
+template <typename T, typename ...P>
+struct HasRange : HasRangeHelper<void, T, P...> {};
+
+// Tests if `T` has `.construct_at(E *)`.
+template <typename Void, typename T, typename E>
+struct HasConstructAtHelper : std::false_type {};
+template <typename T, typename E>
+struct HasConstructAtHelper<decltype(void(std::declval<T>().construct_at(std::declval<E *>()))), T, E> : std::true_type {};
+template <typename T, typename E>
+struct HasConstructAt : HasConstructAtHelper<void, T, E> {};
+
+// Tests if `T` has `.boxed<Base>()`.
+template <typename Void, typename T, typename Base>
+struct HasBoxedHelper : std::false_type {};
+template <typename T, typename Base>
+struct HasBoxedHelper<decltype(void(std::declval<T>().template boxed<Base>())), T, Base> : std::true_type {};
+template <typename T, typename Base>
+struct HasBoxed : HasBoxedHelper<void, T, Base> {};
+
 // Get a `init<P...>` value from element types.
 // Causes UB when called, intended only to instantiate templates.
 template <typename ...P>
@@ -164,12 +283,31 @@ better_list_init::type::BETTERLISTINIT_IDENTIFIER<P...> &&invalid_init_list()
     X(int,                  int, int, int) \
     X(int,                  int, const int, int &, const int &) \
     X(std::unique_ptr<int>, std::nullptr_t &, std::unique_ptr<int>) \
+    /* String literals. */\
+    X(std::string,          const char (&)[2], const char (&)[3]) \
+
+// Uses all members of the iterator that `List` uses to initialize ranges of `T`, and of its reference type.
+// The iterators are shared between lists, so we can't instantiate them explicitly without duplicates.
+template <typename List, typename T>
+struct InstantiateIterator
+{
+    using iterator = typename List::template iterator_t<T>;
+
+    void check(iterator a, iterator b)
+    {
+        (void)T(*a);
+        (void)T(a[0]);
+        ++a; --a; a++; a--;
+        a += 1; a -= 1;
+        (void)(a + 1); (void)(1 + a); (void)(a - 1); (void)(a - b);
+        (void)(a == b); (void)(a != b); (void)(a < b); (void)(a > b); (void)(a <= b); (void)(a >= b);
+    }
+};
 
 // Try to explicitly instantiate the types from `CHECKED_LIST_TYPES`.
 #define CHECK_INSTANTIATION(target_, ...) \
     template class better_list_init::type::BETTERLISTINIT_IDENTIFIER<__VA_ARGS__>; \
-    template class better_list_init::type::BETTERLISTINIT_IDENTIFIER<__VA_ARGS__>::elem_iter<target_>; \
-    template class better_list_init::type::BETTERLISTINIT_IDENTIFIER<__VA_ARGS__>::elem_ref<target_>;
+    template struct InstantiateIterator<better_list_init::type::BETTERLISTINIT_IDENTIFIER<__VA_ARGS__>, target_>;
 CHECKED_LIST_TYPES(CHECK_INSTANTIATION)
 #undef CHECK_INSTANTIATION
 
@@ -184,6 +322,7 @@ struct IteratorCategoryChecker
     {
         #if BETTERLISTINIT_CXX_STANDARD >= 20
         static_assert(std::random_access_iterator<U>, "The iterator concept wasn't satisfied.");
+        static_assert(std::is_same<typename U::iterator_concept, std::random_access_iterator_tag>::value, "Wrong iterator concept.");
         #endif
         static_assert(std::is_same<typename std::iterator_traits<U>::iterator_category, std::random_access_iterator_tag>::value, "Wrong iterator category.");
     }
@@ -313,6 +452,295 @@ struct ConstexprRange
     }
 };
 
+// Opt out of normalizing `unsigned short` to `long long`, see `custom::normalized_elem`.
+template <>
+struct better_list_init::custom::normalized_elem<long long, unsigned short &&> {using type = unsigned short &&;};
+
+// Checks that `.for_each()` forwards the elements with their original types.
+struct ForEachVisitor
+{
+    std::vector<std::unique_ptr<int>> &vec;
+    int &sum;
+
+    void operator()(std::unique_ptr<int> &&ptr) const {vec.push_back(std::move(ptr));}
+    void operator()(int &value) const {sum += value;}
+    void operator()(long &&value) const {sum += int(value);}
+};
+
+#if BETTERLISTINIT_TRACE
+// An element type with tracing hooks, which record the events into `trace_log`.
+// Not trivially copyable, so the copies are distinguishable from moves.
+struct Traced
+{
+    int value = 0;
+    Traced(int value) : value(value) {}
+    Traced(const Traced &other) : value(other.value) {}
+    Traced(Traced &&) = default;
+};
+
+struct TraceLog
+{
+    std::vector<better_list_init::trace_info> constructs;
+    std::vector<int> ended_tokens;
+    std::vector<std::pair<std::size_t, better_list_init::trace_element_kind>> elems;
+};
+TraceLog trace_log;
+
+template <typename List>
+struct better_list_init::custom::trace_construct<void, std::vector<Traced>, List>
+{
+    static int begin(const trace_info &info) noexcept
+    {
+        trace_log.constructs.push_back(info);
+        return int(trace_log.constructs.size());
+    }
+    static void end(const trace_info &, int token) noexcept
+    {
+        trace_log.ended_tokens.push_back(token);
+    }
+};
+template <>
+struct better_list_init::custom::trace_element<void, Traced>
+{
+    static void element(std::size_t index, trace_element_kind kind) noexcept
+    {
+        trace_log.elems.emplace_back(index, kind);
+    }
+};
+#endif
+
+#if BETTERLISTINIT_BOXED
+// Polymorphic types for `.boxed<Base>()`.
+// The base deliberately has no virtual destructor, `poly_buffer` must destroy the objects correctly anyway.
+struct Shape
+{
+    static int alive;
+    Shape() {alive++;}
+    Shape(const Shape &) {alive++;}
+    Shape &operator=(const Shape &) = default;
+    ~Shape() {alive--;}
+    virtual int area() const = 0;
+};
+int Shape::alive = 0;
+struct Square : Shape
+{
+    int side = 0;
+    explicit Square(int side) : side(side) {}
+    int area() const override {return side * side;}
+};
+// Over-aligned, and has a non-trivial destructor.
+struct alignas(32) NamedRect : Shape
+{
+    std::string name;
+    int w = 0, h = 0;
+    NamedRect(std::string name, int w, int h) : name(std::move(name)), w(w), h(h) {}
+    int area() const override {return w * h;}
+};
+// Throws when copied.
+struct ThrowingShape : Shape
+{
+    ThrowingShape() {}
+    ThrowingShape(const ThrowingShape &other) : Shape(other) {throw 42;}
+    int area() const override {return 0;}
+};
+#endif
+
+#if BETTERLISTINIT_COROUTINES
+// A minimal lazy coroutine, for `co_await init{...}`.
+template <typename T>
+struct Task
+{
+    struct promise_type
+    {
+        std::optional<T> value;
+        std::exception_ptr exception;
+        std::coroutine_handle<> continuation;
+
+        // For `SyncWait()`.
+        std::mutex *mutex = nullptr;
+        std::condition_variable *cv = nullptr;
+        bool *done = nullptr;
+
+        Task get_return_object() {return Task(std::coroutine_handle<promise_type>::from_promise(*this));}
+        std::suspend_always initial_suspend() noexcept {return {};}
+        void return_value(T new_value) {value.emplace(std::move(new_value));}
+        void unhandled_exception() {exception = std::current_exception();}
+
+        struct FinalAwaiter
+        {
+            bool await_ready() noexcept {return false;}
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+            {
+                promise_type &promise = handle.promise();
+                if (promise.continuation)
+                    return promise.continuation;
+                std::lock_guard<std::mutex> lock(*promise.mutex);
+                *promise.done = true;
+                promise.cv->notify_one();
+                return std::noop_coroutine();
+            }
+            void await_resume() noexcept {}
+        };
+        FinalAwaiter final_suspend() noexcept {return {};}
+    };
+
+    std::coroutine_handle<promise_type> handle;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+    Task(Task &&other) noexcept : handle(std::exchange(other.handle, {})) {}
+    Task &operator=(Task) = delete;
+    ~Task()
+    {
+        if (handle)
+            handle.destroy();
+    }
+
+    bool await_ready() const noexcept {return false;}
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept
+    {
+        handle.promise().continuation = continuation;
+        return handle;
+    }
+    T await_resume()
+    {
+        if (handle.promise().exception)
+            std::rethrow_exception(handle.promise().exception);
+        return std::move(*handle.promise().value);
+    }
+};
+
+// Runs a task to completion, on the current thread and whatever threads it switches to.
+template <typename T>
+T SyncWait(Task<T> task)
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = false;
+    task.handle.promise().mutex = &mutex;
+    task.handle.promise().cv = &cv;
+    task.handle.promise().done = &done;
+    task.handle.resume();
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&]{return done;});
+    }
+    return task.await_resume();
+}
+
+template <typename T>
+Task<T> Identity(T value)
+{
+    co_return value;
+}
+
+// Waits for `count` tasks to start, on different threads.
+Task<std::thread::id> Rendezvous(std::latch &latch)
+{
+    latch.arrive_and_wait();
+    co_return std::this_thread::get_id();
+}
+
+Task<std::string> Throwing()
+{
+    throw 42;
+    co_return "";
+}
+
+// A fixed-size pool of threads, executing the jobs in FIFO order. An executor for `init{...}.when_all()`.
+class ThreadPool
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::coroutine_handle<>> queue;
+    bool stopping = false;
+    std::vector<std::thread> threads;
+
+    void work()
+    {
+        while (true)
+        {
+            std::coroutine_handle<> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [&]{return stopping || !queue.empty();});
+                if (queue.empty())
+                    return;
+                job = queue.front();
+                queue.pop_front();
+            }
+            job.resume();
+        }
+    }
+
+  public:
+    explicit ThreadPool(unsigned num_threads)
+    {
+        for (unsigned i = 0; i < num_threads; i++)
+            threads.emplace_back([this]{work();});
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // Finishes the queued jobs, then joins the threads.
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cv.notify_all();
+        for (std::thread &thread : threads)
+            thread.join();
+    }
+
+    std::size_t size() const {return threads.size();}
+
+    // The executor interface for `init{...}.when_all()`.
+    void post(std::coroutine_handle<> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(job);
+        }
+        cv.notify_one();
+    }
+};
+#endif
+
+#if BETTERLISTINIT_SHARED_ARRAY
+// An allocator that counts the allocations, for `std::shared_ptr<T[]>`.
+template <typename T>
+struct CountingAllocator
+{
+    using value_type = T;
+
+    int *allocations = nullptr; // Total.
+    int *live = nullptr; // Not deallocated yet.
+
+    CountingAllocator(int *allocations, int *live) : allocations(allocations), live(live) {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U> &other) : allocations(other.allocations), live(other.live) {}
+
+    T *allocate(std::size_t n)
+    {
+        ++*allocations;
+        ++*live;
+        return std::allocator<T>{}.allocate(n);
+    }
+    void deallocate(T *ptr, std::size_t n)
+    {
+        --*live;
+        std::allocator<T>{}.deallocate(ptr, n);
+    }
+
+    template <typename U>
+    friend bool operator==(const CountingAllocator &a, const CountingAllocator<U> &b) {return a.allocations == b.allocations && a.live == b.live;}
+    template <typename U>
+    friend bool operator!=(const CountingAllocator &a, const CountingAllocator<U> &b) {return !(a == b);}
+};
+#endif
+
 int main()
 {
     // Iterator sanity tests.
@@ -623,6 +1051,19 @@ int main()
         static_assert(ConstexprRange<int, const double &, int>(INIT(x1, x2, x3).and_with(x3, 4)).sum == 13, "");
     }
 
+    { // Long lists in constant expressions, which must stay within the default compiler limits.
+        constexpr int x1 = 1;
+        constexpr float x2 = 2.1f;
+
+        // Homogeneous.
+        static_assert(ConstexprRange<int>(INIT(REPEAT_10000(x1))).sum == 10000, "");
+        // Non-range.
+        constexpr std::array<int, 10000> arr = INIT(REPEAT_10000(x1));
+        static_assert(arr[0] == 1 && arr[9999] == 1, "");
+        // Heterogeneous. Those are slower to compile, so the list is shorter, but it's still longer than the default template depth limit.
+        static_assert(ConstexprRange<int>(INIT(REPEAT_100(x1, x2, x1, x2, x1, x2, x1, x2, x1, x2))).sum == 1500, "");
+    }
+
     { // Nested lists with explicit constructors.
         // Non-range element.
         std::vector<ExplicitNonRange> vec1 = INIT(INIT(1,2), INIT(3,4), INIT(5,6));
@@ -708,6 +1149,1068 @@ int main()
         ASSERT_EQ(z, 3);
     }
 
+    { // Compile-time element access.
+        int x = 1;
+        const float y = 2.5f;
+
+        // Lvalue-only lists have unconstrained accessors.
+        auto list = INIT(x, y);
+        static_assert(std::is_same<decltype(list.get<0>()), int &>::value, "");
+        static_assert(std::is_same<decltype(list.get<1>()), const float &>::value, "");
+        ASSERT_EQ(&list.get<0>(), &x);
+        ASSERT_EQ(&list.get<1>(), &y);
+        static_assert(std::tuple_size<decltype(list)>::value == 2, "");
+        static_assert(std::is_same<std::tuple_element<1, decltype(list)>::type, const float &>::value, "");
+
+        // Non-lvalue-only lists forward rvalues.
+        static_assert(std::is_same<decltype(INIT(x, 2.5).get<1>()), double &&>::value, "");
+        ASSERT_EQ(INIT(x, 2.5).get<1>(), 2.5);
+
+        ASSERT_EQ(INIT(1, 2.5f, short(3)).apply([](int a, float b, short c){return a + b + c;}), 6.5f);
+        ASSERT_EQ(INIT().apply([]{return 42;}), 42);
+
+        // `.for_each()` visits the elements in order, with their original types.
+        std::vector<std::unique_ptr<int>> vec;
+        int sum = 0;
+        INIT(std::make_unique<int>(1), x, 3L).for_each(ForEachVisitor{vec, sum});
+        ASSERT_EQ(vec.size(), 1);
+        ASSERT_EQ(sum, 4);
+
+        #if BETTERLISTINIT_CXX_STANDARD >= 17
+        { // Structured bindings.
+            auto [a, b] = INIT(x, y);
+            static_assert(std::is_same<decltype(a), int &>::value, "");
+            ASSERT_EQ(&a, &x);
+            ASSERT_EQ(&b, &y);
+        }
+
+        // Constexpr lambdas.
+        static_assert(INIT(1, 2.5).apply([](int a, double b){return a + b;}) == 3.5, "");
+        #endif
+    }
+
+    { // Viewing heterogeneous lists as homogeneous ones.
+        struct Base {int value = 0;};
+        struct Derived : Base {};
+        Base a;
+        Derived b;
+        Base c;
+
+        auto list = INIT(a, b, c).as<Base &>();
+        static_assert(std::is_same<decltype(list), better_list_init::type::BETTERLISTINIT_IDENTIFIER<Base &, Base &, Base &>>::value, "");
+        int i = 1;
+        for (Base &elem : list)
+            elem.value = i++;
+        ASSERT_EQ(a.value, 1);
+        ASSERT_EQ(b.value, 2);
+        ASSERT_EQ(c.value, 3);
+
+        const Derived &const_b = b;
+        ASSERT_EQ(INIT(a, const_b).as<const Base &>().get<1>().value, 2);
+
+        // Not convertible.
+        static_assert(!HasAs<decltype(INIT(a, b, c)), Derived &>::value, "");
+        // Not a reference.
+        static_assert(!HasAs<decltype(INIT(a, b, c)), Base>::value, "");
+        // Would bind to temporaries.
+        long l = 2;
+        static_assert(!HasAs<decltype(INIT(i, l)), const long &>::value, "");
+        static_assert(HasAs<decltype(INIT(l, l)), const long &>::value, "");
+
+        #if BETTERLISTINIT_CXX_STANDARD >= 17
+        // Lists of rvalue references.
+        std::unique_ptr<int> p1 = std::make_unique<int>(1);
+        std::unique_ptr<int> p2 = std::make_unique<int>(2);
+        auto rvalue_list = INIT(std::move(p1), std::move(p2)).as<std::unique_ptr<int> &&>();
+        std::vector<std::unique_ptr<int>> vec(std::move(rvalue_list).begin(), std::move(rvalue_list).end());
+        ASSERT_EQ(vec.size(), 2);
+        ASSERT(!p1 && !p2 && *vec[0] == 1 && *vec[1] == 2);
+        // The iterators are rvalue-only, like for other lists with rvalues, so range-for doesn't work.
+        static_assert(!HasBeginEnd<decltype(rvalue_list) &>::value, "");
+        #endif
+
+        #if BETTERLISTINIT_CXX_STANDARD >= 20
+        // `std::common_reference_t` is used by default.
+        static_assert(std::is_same<decltype(INIT(a, b, c).as()), decltype(list)>::value);
+        static_assert(!HasAs<decltype(INIT(1, 2L))>::value);
+        #endif
+    }
+
+    { // Owning prototype lists.
+        #if BETTERLISTINIT_ALLOW_BRACES
+        #define PROTOTYPE(...) better_list_init::prototype{__VA_ARGS__}
+        #else
+        #define PROTOTYPE(...) better_list_init::prototype(__VA_ARGS__)
+        #endif
+
+        auto proto = PROTOTYPE(std::string("alpha"), "beta", std::string("gamma"));
+        static_assert(std::is_same<decltype(proto), better_list_init::type::prototype<std::string, const char *, std::string>>::value, "");
+        for (int i = 0; i < 2; i++)
+        {
+            // Lvalue conversions copy the elements.
+            std::vector<std::string> vec = proto;
+            ASSERT_EQ(vec.size(), 3);
+            ASSERT_EQ(vec[0], "alpha");
+            ASSERT_EQ(vec[1], "beta");
+            ASSERT_EQ(vec[2], "gamma");
+        }
+        std::array<std::string, 3> arr = proto;
+        ASSERT_EQ(arr[0], "alpha");
+
+        // Rvalue conversions move them.
+        std::vector<std::string> vec = std::move(proto);
+        ASSERT_EQ(vec[0], "alpha");
+
+        // Non-copyable elements must be wrapped in factories.
+        int counter = 0;
+        auto make_ptr = [&counter]{return std::make_unique<int>(++counter);};
+        auto ptr_proto = PROTOTYPE(better_list_init::factory(make_ptr), better_list_init::factory(make_ptr));
+        for (int i = 0; i < 2; i++)
+        {
+            std::vector<std::unique_ptr<int>> ptrs = ptr_proto;
+            ASSERT_EQ(ptrs.size(), 2);
+            ASSERT_EQ(*ptrs[0], i * 2 + 1);
+            ASSERT_EQ(*ptrs[1], i * 2 + 2);
+        }
+
+        #if CONTAINERS_HAVE_MANDATORY_COPY_ELISION
+        auto make_atomic = []{return 42;};
+        const auto atomic_proto = PROTOTYPE(1, better_list_init::factory(make_atomic));
+        std::vector<std::atomic_int> atomics = atomic_proto;
+        ASSERT_EQ(atomics[0].load(), 1);
+        ASSERT_EQ(atomics[1].load(), 42);
+
+        // Nested prototypes.
+        const auto map_proto = PROTOTYPE(PROTOTYPE(1, std::string("one")), PROTOTYPE(2, std::string("two")));
+        std::map<int, std::string> map = map_proto;
+        ASSERT_EQ(map.size(), 2);
+        ASSERT_EQ(map.at(2), "two");
+        #endif
+
+        // Extra constructor arguments.
+        std::vector<std::string> vec2 = proto.list().and_with(std::allocator<std::string>{});
+        ASSERT_EQ(vec2.size(), 3);
+
+        #undef PROTOTYPE
+    }
+
+    { // Optional elements.
+        using better_list_init::when;
+
+        auto p1 = std::make_unique<int>(1);
+        auto p2 = std::make_unique<int>(2);
+        auto p3 = std::make_unique<int>(3);
+        std::vector<std::unique_ptr<int>> ptrs = INIT(std::move(p1), when(false, std::move(p2)), when(true, std::move(p3)));
+        ASSERT_EQ(ptrs.size(), 2);
+        ASSERT(!p1 && p2 && !p3);
+        ASSERT_EQ(*ptrs[0], 1);
+        ASSERT_EQ(*ptrs[1], 3);
+
+        // The container receives the exact size.
+        int x = 10;
+        std::vector<int> vec = INIT(when(true, 1), when(false, x), 2, when(true, x), when(false, 3));
+        ASSERT_EQ(vec.size(), 3);
+        ASSERT_EQ(vec.capacity(), 3);
+        ASSERT_EQ(vec[0], 1);
+        ASSERT_EQ(vec[1], 2);
+        ASSERT_EQ(vec[2], 10);
+
+        // All elements disabled.
+        std::vector<int> empty = INIT(when(false, 1), when(false, 2));
+        ASSERT(empty.empty());
+
+        // Lists with optional elements are never homogeneous, and can't initialize non-ranges.
+        static_assert(!decltype(INIT(when(true, 1), when(true, 2)))::is_homogeneous, "");
+        static_assert(!std::is_constructible<std::array<int, 2>, decltype(INIT(1, when(true, 2)))>::value, "");
+        static_assert(std::is_constructible<std::vector<int>, decltype(INIT(1, when(true, 2)))>::value, "");
+        static_assert(!std::is_constructible<std::vector<std::string>, decltype(INIT(std::string{}, when(true, 2)))>::value, "");
+
+        // Optional lvalues.
+        const auto opt = when(true, x);
+        std::vector<int> vec2 = INIT(opt, opt);
+        ASSERT_EQ(vec2.size(), 2);
+        ASSERT_EQ(vec2[1], 10);
+    }
+
+    { // Spliced ranges.
+        using better_list_init::spread;
+        using better_list_init::when;
+
+        std::vector<std::unique_ptr<int>> source;
+        source.push_back(std::make_unique<int>(2));
+        source.push_back(std::make_unique<int>(3));
+        std::vector<std::unique_ptr<int>> empty_source;
+        auto p1 = std::make_unique<int>(1);
+        auto p4 = std::make_unique<int>(4);
+
+        // Move-only elements are moved from rvalue ranges.
+        std::vector<std::unique_ptr<int>> ptrs = INIT(std::move(p1), spread(std::move(empty_source)), spread(std::move(source)), std::move(p4));
+        ASSERT_EQ(ptrs.size(), 4);
+        ASSERT_EQ(ptrs.capacity(), 4);
+        for (int i = 0; i < 4; i++)
+            ASSERT_EQ(*ptrs[std::size_t(i)], i + 1);
+        ASSERT_EQ(source.size(), 2);
+        ASSERT(!source[0] && !source[1]);
+
+        // Lvalue ranges are copied. Arrays work too. Mixing with optional elements.
+        std::vector<int> ints = {3, 4};
+        const int arr[] = {6, 7, 8};
+        std::vector<int> vec = INIT(spread(ints), 5, when(false, 100), spread(arr), when(true, 9));
+        ASSERT_EQ(vec.size(), 7);
+        ASSERT_EQ(vec.capacity(), 7);
+        ASSERT_EQ(vec[0], 3);
+        ASSERT_EQ(vec[2], 5);
+        ASSERT_EQ(vec[3], 6);
+        ASSERT_EQ(vec[5], 8);
+        ASSERT_EQ(vec[6], 9);
+        ASSERT_EQ(ints.size(), 2);
+
+        // Converting elements.
+        std::vector<std::string> strings = INIT("a", spread(std::vector<const char *>{"b", "c"}), std::string("d"));
+        ASSERT_EQ(strings.size(), 4);
+        ASSERT_EQ(strings[2], "c");
+        ASSERT_EQ(strings[3], "d");
+
+        // Random access.
+        std::deque<int> deq = INIT(1, spread(ints), spread(ints), 2);
+        ASSERT_EQ(deq.size(), 6);
+        ASSERT_EQ(deq[4], 4);
+        ASSERT_EQ(deq[5], 2);
+
+        #if BETTERLISTINIT_CXX_STANDARD >= 17
+        // Types constructible from anything get the elements, rather than the references to them.
+        std::vector<std::any> anys = INIT(1, spread(ints));
+        ASSERT_EQ(anys.size(), 3);
+        ASSERT_EQ(std::any_cast<int>(anys[0]), 1);
+        ASSERT_EQ(std::any_cast<int>(anys[2]), 4);
+        #endif
+
+        // Iterator sanity, with empty ranges in between.
+        std::vector<int> no_ints;
+        (void)IteratorSanityChecker(INIT(spread(no_ints), 1, spread(no_ints), spread(std::vector<int>{2, 3}), spread(no_ints)));
+        (void)IteratorCategoryChecker<int>(INIT(spread(ints), 1));
+
+        // Only ranges can be initialized.
+        static_assert(!std::is_constructible<std::array<int, 2>, decltype(INIT(spread(ints)))>::value, "");
+        static_assert(std::is_constructible<std::set<int>, decltype(INIT(spread(ints)))>::value, "");
+    }
+
+    { // Generated and repeated elements.
+        using better_list_init::generate;
+        using better_list_init::repeat;
+        using better_list_init::spread;
+
+        // A runtime number of elements, with per-index arguments.
+        std::size_t n = 4;
+        std::vector<std::string> strings = INIT("a", generate(n, [](std::size_t i){return std::string(i, 'x');}), "b");
+        ASSERT_EQ(strings.size(), 6);
+        ASSERT_EQ(strings.capacity(), 6);
+        ASSERT_EQ(strings[0], "a");
+        ASSERT_EQ(strings[1], "");
+        ASSERT_EQ(strings[4], "xxx");
+        ASSERT_EQ(strings[5], "b");
+
+        // Repeated elements are copied.
+        std::string value = "foo";
+        std::vector<std::string> copies = INIT(repeat(3, value), spread(strings), repeat(0, value), repeat(1, "bar"));
+        ASSERT_EQ(copies.size(), 10);
+        ASSERT_EQ(copies[2], "foo");
+        ASSERT_EQ(copies[3], "a");
+        ASSERT_EQ(copies[9], "bar");
+        ASSERT_EQ(value, "foo");
+
+        #if CONTAINERS_HAVE_MANDATORY_COPY_ELISION
+        // Non-movable elements, constructed from the function results or the repeated value.
+        std::vector<std::atomic_int> atomics = INIT(generate(n, [](std::size_t i){return int(i) * 10;}), repeat(2, 42));
+        ASSERT_EQ(atomics.size(), 6);
+        ASSERT_EQ(atomics[3].load(), 30);
+        ASSERT_EQ(atomics[5].load(), 42);
+
+        // The function can even return non-movable elements by value, they're constructed in place.
+        std::vector<std::atomic_int> atomics2 = INIT(generate(n, [](std::size_t i){return std::atomic_int(int(i));}));
+        ASSERT_EQ(atomics2.size(), 4);
+        ASSERT_EQ(atomics2[3].load(), 3);
+        #endif
+
+        // `.transform(f)` receives the function results.
+        std::vector<std::size_t> lengths = INIT(generate(n, [](std::size_t i){return std::string(i, 'x');})).transform([](std::string &&str){return str.size();});
+        ASSERT((lengths == std::vector<std::size_t>{0, 1, 2, 3}));
+
+        #if BETTERLISTINIT_CXX_STANDARD >= 17
+        // Types constructible from anything get the function results.
+        std::vector<std::any> anys = INIT(generate(2, [](std::size_t i){return int(i) + 1;}), repeat(1, 3));
+        ASSERT_EQ(anys.size(), 3);
+        ASSERT_EQ(std::any_cast<int>(anys[1]), 2);
+        ASSERT_EQ(std::any_cast<int>(anys[2]), 3);
+        #endif
+
+        (void)IteratorSanityChecker(INIT(generate(1, [](std::size_t i){return int(i) + 1;}), 2, repeat(1, 3)));
+
+        // Only ranges can be initialized.
+        static_assert(!std::is_constructible<std::array<int, 2>, decltype(INIT(repeat(2, 1)))>::value, "");
+    }
+
+    { // Normalizing "almost homogeneous" lists.
+        using better_list_init::detail::elem_iter;
+        using better_list_init::detail::elem_ref;
+
+        // Scalars are converted to the target type up front, then the list is converted as if it was homogeneous.
+        static_assert(std::is_same<decltype(INIT(1, 2u, 3L))::iterator_t<long>, elem_iter<long &&>>::value, "");
+        std::vector<long> longs = INIT(1, 2u, 3L);
+        ASSERT((longs == std::vector<long>{1, 2, 3}));
+        int x = 4;
+        std::vector<int> ints = INIT(x, 5, short(6));
+        ASSERT((ints == std::vector<int>{4, 5, 6}));
+        static_assert(ConstexprRange<int>(INIT(1, 2L, short(3))).sum == 6, "");
+
+        // Lvalues of the same trivially copyable type are bound to const references, regardless of their constness.
+        std::array<int, 2> arr_a = {1, 2};
+        const std::array<int, 2> arr_b = {3, 4};
+        static_assert(std::is_same<decltype(INIT(arr_a, arr_b))::iterator_t<std::array<int, 2>>, elem_iter<const std::array<int, 2> &>>::value, "");
+        std::vector<std::array<int, 2>> arrays = INIT(arr_a, arr_b, arr_a);
+        ASSERT((arrays == std::vector<std::array<int, 2>>{{{1, 2}}, {{3, 4}}, {{1, 2}}}));
+
+        // Other types could have a separate `T(T &)` constructor, so their lvalues aren't normalized.
+        std::string a = "a";
+        const std::string b = "b";
+        static_assert(std::is_same<decltype(INIT(a, b))::iterator_t<std::string>, elem_iter<elem_ref<std::string, false>>>::value, "");
+        std::vector<std::string> strings = INIT(a, b, a);
+        ASSERT((strings == std::vector<std::string>{"a", "b", "a"}));
+        ASSERT_EQ(a, "a");
+
+        #if LANG_HAS_MANDATORY_COPY_ELISION
+        {
+            struct A
+            {
+                bool from_nonconst = false;
+                A() {}
+                A(A &) : from_nonconst(true) {}
+                A(const A &) {}
+            };
+            A x;
+            const A y;
+            std::vector<A> vec = INIT(x, y);
+            ASSERT(vec[0].from_nonconst && !vec[1].from_nonconst);
+        }
+        #endif
+
+        // Mixing lvalues and rvalues of class types would change the semantics, so those remain heterogeneous.
+        static_assert(std::is_same<decltype(INIT(a, std::string("c")))::iterator_t<std::string>, elem_iter<elem_ref<std::string, false>>>::value, "");
+        // Same for targets that can't be normalized to.
+        static_assert(std::is_same<decltype(INIT(1, 2L))::iterator_t<std::string>, elem_iter<elem_ref<std::string, false>>>::value, "");
+        // And for user specializations that opt out.
+        static_assert(std::is_same<decltype(INIT(1, (unsigned short)2))::iterator_t<long long>, elem_iter<elem_ref<long long, true>>>::value, "");
+        std::vector<long long> long_longs = INIT(1, (unsigned short)2);
+        ASSERT((long_longs == std::vector<long long>{1, 2}));
+
+        #if BETTERLISTINIT_CXX_STANDARD >= 17
+        auto range = INIT(1, 2u, 3L).range<long>();
+        ASSERT_EQ(range.begin()[2], 3);
+        #endif
+    }
+
+    { // Lists of string literals.
+        using list_t = decltype(INIT("alpha", "be", "gamma"));
+
+        // Those iterate over `(pointer, length)` pairs, rather than being type-erased.
+        static_assert(std::is_same<list_t::iterator_t<std::string>, better_list_init::detail::elem_iter<better_list_init::detail::char_array_ref<std::string, char>>>::value, "");
+        static_assert(std::is_same<decltype(INIT("ab", "cd"))::iterator_t<std::string>, list_t::iterator_t<std::string>>::value, "");
+        // But only if the elements can be constructed from a pointer and a length.
+        static_assert(std::is_same<list_t::iterator_t<const char *>, better_list_init::detail::elem_iter<better_list_init::detail::elem_ref<const char *, true>>>::value, "");
+        static_assert(!std::is_same<decltype(INIT("a", std::string("b")))::iterator_t<std::string>, list_t::iterator_t<std::string>>::value, "");
+
+        std::vector<std::string> vec = INIT("alpha", "be", "gamma");
+        ASSERT((vec == std::vector<std::string>{"alpha", "be", "gamma"}));
+        std::set<std::string> set = INIT("b", "a", "ccc");
+        ASSERT((set == std::set<std::string>{"a", "b", "ccc"}));
+        std::vector<std::wstring> wide = INIT(L"a", L"bc");
+        ASSERT((wide == std::vector<std::wstring>{L"a", L"bc"}));
+        std::vector<const char *> pointers = INIT("alpha", "be");
+        ASSERT_EQ(std::string(pointers[1]), "be");
+
+        // The length stops at the first null, like `strlen()`, even if there's non-null garbage after it.
+        const char buffer[8] = "buf";
+        char junk[10] = "ab\0junk";
+        const char (&junk_ref)[10] = junk;
+        vec = INIT("a\0b", buffer, "", junk_ref);
+        ASSERT_EQ(vec.size(), 4);
+        ASSERT_EQ(vec[0], "a");
+        ASSERT_EQ(vec[1], "buf");
+        ASSERT_EQ(vec[2], "");
+        ASSERT_EQ(vec[3], "ab");
+        // But it never goes past the end of the array.
+        const char no_null[2] = {'x', 'y'};
+        vec = INIT(no_null, "z");
+        ASSERT_EQ(vec[0], "xy");
+
+        #if BETTERLISTINIT_CXX_STANDARD >= 17
+        // Also when viewing the list as a range.
+        auto range = INIT("alpha", "be").range<std::string>();
+        ASSERT_EQ(std::string(range.begin()[1]), "be");
+        #endif
+    }
+
+    { // Transforming the elements.
+        using better_list_init::spread;
+
+        auto wrap = [](const auto &x) {return std::to_string(x);};
+        std::vector<std::string> strings = INIT(1, 2L, 3u).transform(wrap);
+        ASSERT_EQ(strings.size(), 3);
+        ASSERT_EQ(strings[0], "1");
+        ASSERT_EQ(strings[2], "3");
+
+        // The elements are forwarded.
+        auto p1 = std::make_unique<int>(1);
+        auto p2 = std::make_unique<int>(2);
+        std::vector<std::shared_ptr<int>> shared = INIT(std::move(p1), std::move(p2)).transform([](std::unique_ptr<int> &&p){return std::shared_ptr<int>(std::move(p));});
+        ASSERT_EQ(shared.size(), 2);
+        ASSERT(!p1 && !p2 && *shared[1] == 2);
+
+        // With indices, with spliced ranges, and with extra conversions.
+        std::vector<int> ints = {10, 20};
+        std::vector<long> longs = INIT(1, spread(ints), 2).transform_indexed([](std::size_t i, int x){return int(i) * 100 + x;});
+        ASSERT_EQ(longs.size(), 4);
+        ASSERT_EQ(longs[0], 1);
+        ASSERT_EQ(longs[1], 110);
+        ASSERT_EQ(longs[2], 220);
+        ASSERT_EQ(longs[3], 302);
+
+        #if BETTERLISTINIT_CXX_STANDARD >= 17
+        // Types constructible from anything get the transformed elements, including ones from spliced ranges and `generate()`.
+        std::vector<std::any> anys = INIT(spread(ints), better_list_init::generate(1, [](std::size_t i){return int(i) + 3;})).transform_indexed([](std::size_t i, int x){return int(i) * 100 + x;});
+        ASSERT_EQ(anys.size(), 3);
+        ASSERT_EQ(std::any_cast<int>(anys[1]), 120);
+        ASSERT_EQ(std::any_cast<int>(anys[2]), 203);
+        #endif
+
+        std::vector<int> empty = INIT().transform(wrap);
+        ASSERT(empty.empty());
+
+        // Iterator sanity.
+        (void)IteratorSanityChecker(INIT(0, 1, 2).transform([](int x){return x + 1;}));
+
+        // Only ranges can be initialized, and the results must be convertible.
+        static_assert(!std::is_constructible<std::array<std::string, 1>, decltype(INIT(1).transform(wrap))>::value, "");
+        static_assert(!std::is_constructible<std::vector<int *>, decltype(INIT(1).transform(wrap))>::value, "");
+
+        #if CONTAINERS_HAVE_MANDATORY_COPY_ELISION
+        // Non-movable results are constructed in place.
+        std::vector<std::atomic_int> atomics = INIT(1, 2).transform([](int x){return std::atomic_int(x * 10);});
+        ASSERT_EQ(atomics.size(), 2);
+        ASSERT_EQ(atomics[1].load(), 20);
+        #endif
+    }
+
+    #if BETTERLISTINIT_CXX_STANDARD >= 17
+    { // Viewing lists as ranges.
+        using better_list_init::spread;
+        using better_list_init::when;
+
+        std::string a = "a";
+        std::vector<std::string> source = {"b", "c"};
+
+        // Homogeneous, the element type is deduced.
+        auto check_homogeneous = [](auto &&range)
+        {
+            ASSERT_EQ(range.size(), 2);
+            std::vector<std::string> vec(range.begin(), range.end());
+            ASSERT_EQ(vec[1], "y");
+        };
+        check_homogeneous(INIT(std::string("x"), std::string("y")).range());
+
+        // Heterogeneous, with optional elements and spliced ranges.
+        auto check = [](auto &&range, std::vector<std::string> expected)
+        {
+            #if BETTERLISTINIT_CXX_STANDARD >= 20
+            using range_t = std::remove_reference_t<decltype(range)>;
+            static_assert(std::ranges::random_access_range<range_t>);
+            static_assert(std::ranges::sized_range<range_t>);
+            ASSERT_EQ(std::ranges::size(range), expected.size());
+            #endif
+            ASSERT_EQ(range.size(), expected.size());
+            ASSERT_EQ(range.empty(), expected.empty());
+            std::vector<std::string> vec;
+            vec.insert(vec.end(), range.begin(), range.end());
+            ASSERT(vec == expected);
+        };
+        check(INIT(a, "x", std::string("y")).range<std::string>(), {"a", "x", "y"});
+        check(INIT(a, when(false, "x"), "y").range<std::string>(), {"a", "y"});
+        check(INIT("x", spread(source), "y").range<std::string>(), {"x", "b", "c", "y"});
+        check(INIT().range<std::string>(), {});
+        ASSERT_EQ(a, "a");
+
+        // Heterogeneous lists must specify the element type.
+        static_assert(!HasRange<decltype(INIT(1, 2L))>::value, "");
+        static_assert(HasRange<decltype(INIT(1, 2L)), long>::value, "");
+        static_assert(!HasRange<decltype(INIT(1, 2L)), std::string>::value, "");
+
+        #if BETTERLISTINIT_CXX_STANDARD >= 20
+        // Lvalue-only homogeneous lists are sized ranges themselves.
+        auto list = INIT(a, a, a);
+        static_assert(std::ranges::random_access_range<decltype(list) &>);
+        static_assert(std::ranges::sized_range<decltype(list) &>);
+        ASSERT_EQ(std::ranges::size(list), 3);
+        #endif
+    }
+    #endif
+
+    { // Strict mode, rejecting copied elements.
+        using better_list_init::custom::is_element_copy;
+
+        std::string a = "a", b = "b";
+        const char *c = "c";
+        std::vector<std::string> strings = INIT(std::move(a), std::string(b), c, "d").strict();
+        ASSERT_EQ(strings.size(), 4);
+        ASSERT_EQ(strings[0], "a");
+        ASSERT_EQ(strings[1], "b");
+        ASSERT_EQ(strings[3], "d");
+        ASSERT(a.empty() && b == "b");
+
+        std::vector<int> ints = INIT(1, 2).strict();
+        ASSERT_EQ(ints.size(), 2);
+
+        // Lvalues and const rvalues of the same class (or derived ones) are copies, unless trivially copyable.
+        static_assert(is_element_copy<std::string, std::string &>::value, "");
+        static_assert(is_element_copy<std::string, const std::string &>::value, "");
+        static_assert(is_element_copy<std::string, const std::string &&>::value, "");
+        static_assert(!is_element_copy<std::string, std::string &&>::value, "");
+        static_assert(!is_element_copy<std::string, std::string>::value, "");
+        static_assert(!is_element_copy<std::string, const char *&>::value, "");
+        static_assert(!is_element_copy<int, int &>::value, "");
+
+        // Only ranges can be initialized.
+        static_assert(std::is_constructible<std::vector<int>, decltype(INIT(1, 2).strict())>::value, "");
+        static_assert(!std::is_constructible<std::array<int, 2>, decltype(INIT(1, 2).strict())>::value, "");
+        static_assert(!std::is_constructible<ExplicitNonRange, decltype(INIT(1, 2).strict())>::value, "");
+    }
+
+    { // Performance lint checks (reported only with `BETTERLISTINIT_LINT`).
+        using namespace better_list_init::detail;
+
+        static_assert(lint_all_scalars<std::vector<int>, int, int>::value, "");
+        static_assert(lint_all_scalars<std::array<int *, 1>, int *&>::value, "");
+        static_assert(!lint_all_scalars<std::vector<int>>::value, "");
+        static_assert(!lint_all_scalars<std::vector<std::string>, int, std::string>::value, "");
+        static_assert(!lint_all_scalars<std::vector<int>, int, better_list_init::type::spread<std::vector<int> &>>::value, "");
+
+        static_assert(lint_needlessly_heterogeneous<std::vector<std::string>, std::string &, std::string>::value, "");
+        // Those are converted as if they were homogeneous, see `custom::normalized_elem`.
+        static_assert(!lint_needlessly_heterogeneous<std::vector<std::array<int, 2>>, const std::array<int, 2> &, std::array<int, 2> &>::value, "");
+        // But not non-trivially-copyable lvalues, see `custom::normalized_elem`.
+        static_assert(lint_needlessly_heterogeneous<std::vector<std::string>, const std::string &, std::string &>::value, "");
+        static_assert(!lint_needlessly_heterogeneous<std::vector<long>, int, long, unsigned>::value, "");
+        static_assert(!lint_needlessly_heterogeneous<std::vector<std::string>, std::string, std::string>::value, "");
+        static_assert(!lint_needlessly_heterogeneous<std::vector<std::string>, std::string, const char *>::value, "");
+        static_assert(!lint_needlessly_heterogeneous<std::array<long, 2>, int, long>::value, "");
+
+        static_assert(lint_element_temporaries<std::vector<std::string>, std::string, const char *>::value == (BETTERLISTINIT_CXX_STANDARD < 17), "");
+        static_assert(!lint_element_temporaries<std::vector<std::string>, std::string, std::string>::value, "");
+        static_assert(!lint_element_temporaries<std::vector<int>, int, long>::value, "");
+        static_assert(!lint_element_temporaries<std::array<std::string, 2>, std::string, const char *>::value, "");
+
+        static_assert(!lint_too_long<std::vector<int>, int, int>::value, "");
+
+        // Each check has its own diagnostic, which is silent unless the check fired.
+        static_assert(std::is_base_of<lint_passed, all_scalar_list_use_plain_braces<false, std::vector<int>, int>>::value, "");
+        static_assert(!std::is_base_of<lint_passed, all_scalar_list_use_plain_braces<true, std::vector<int>, int>>::value, "");
+    }
+
+    #if BETTERLISTINIT_TRACE
+    { // Tracing hooks.
+        using better_list_init::spread;
+        using better_list_init::trace_path;
+        using better_list_init::trace_element_kind;
+        using better_list_init::when;
+
+        Traced a(1), b(2);
+        std::vector<Traced> vec1 = INIT(a, b);
+        std::vector<Traced> vec2 = INIT(std::move(a), 3, when(false, b));
+        std::vector<Traced> vec3 = INIT(spread(vec1), 4);
+        ASSERT_EQ(vec3.size(), 3);
+
+        ASSERT_EQ(trace_log.constructs.size(), 3);
+        ASSERT(trace_log.constructs[0].path == trace_path::homogeneous && trace_log.constructs[0].size == 2);
+        ASSERT(trace_log.constructs[1].path == trace_path::heterogeneous && trace_log.constructs[1].size == 2);
+        ASSERT(trace_log.constructs[2].path == trace_path::proxied && trace_log.constructs[2].size == 3);
+        ASSERT((trace_log.ended_tokens == std::vector<int>{1, 2, 3}));
+
+        using elem = std::pair<std::size_t, trace_element_kind>;
+        ASSERT((trace_log.elems == std::vector<elem>{
+            {0, trace_element_kind::copy}, {1, trace_element_kind::copy},
+            {0, trace_element_kind::move}, {1, trace_element_kind::convert},
+            {0, trace_element_kind::copy}, {1, trace_element_kind::copy}, {2, trace_element_kind::convert},
+        }));
+    }
+    #endif
+
+    #if BETTERLISTINIT_PARALLEL
+    { // Parallel construction.
+        using better_list_init::fixed_buffer;
+        using better_list_init::spread;
+
+        // Sequential construction of `fixed_buffer`.
+        fixed_buffer<std::string> seq = INIT("a", std::string("b"));
+        ASSERT_EQ(seq.size(), 2);
+        ASSERT_EQ(seq[0], "a");
+        ASSERT_EQ(seq[1], "b");
+
+        std::vector<int> ints;
+        for (int i = 0; i < 100; i++)
+            ints.push_back(i);
+
+        // Standard containers.
+        std::vector<long> longs = INIT(-1, spread(ints), -2).parallel(4);
+        ASSERT_EQ(longs.size(), 102);
+        ASSERT_EQ(longs.front(), -1);
+        ASSERT_EQ(longs[51], 50);
+        ASSERT_EQ(longs.back(), -2);
+
+        std::set<int> set = INIT(3, 1, 2).parallel();
+        ASSERT_EQ(set.size(), 3);
+        ASSERT_EQ(*set.begin(), 1);
+
+        // Rvalue elements are moved exactly once.
+        auto p1 = std::make_unique<int>(1);
+        auto p2 = std::make_unique<int>(2);
+        std::vector<std::unique_ptr<int>> ptrs = INIT(std::move(p1), std::move(p2)).parallel(2);
+        ASSERT(!p1 && !p2 && *ptrs[0] == 1 && *ptrs[1] == 2);
+
+        // `fixed_buffer` and `std::unique_ptr<T[], fixed_buffer_deleter<T>>`.
+        fixed_buffer<long> buffer = INIT(spread(ints)).parallel(3);
+        ASSERT_EQ(buffer.size(), 100);
+        ASSERT_EQ(buffer[99], 99);
+        std::unique_ptr<std::string[], better_list_init::fixed_buffer_deleter<std::string>> array = INIT("a", "b", "c").parallel(8);
+        ASSERT_EQ(array[2], "c");
+        ASSERT_EQ(array.get_deleter().count, 3);
+        // Plain `std::unique_ptr<T[]>` would have to default-construct the elements first.
+        static_assert(!std::is_constructible<std::unique_ptr<std::string[]>, decltype(INIT("a").parallel())>::value, "");
+
+        // Releasing a buffer.
+        fixed_buffer<std::string> released = INIT("x", "y");
+        std::unique_ptr<std::string[], better_list_init::fixed_buffer_deleter<std::string>> released_ptr = released.release();
+        ASSERT(released.empty() && released.data() == nullptr);
+        ASSERT_EQ(released_ptr[1], "y");
+
+        // Empty lists and a single thread.
+        fixed_buffer<int> empty = INIT().parallel();
+        ASSERT(empty.empty() && empty.begin() == empty.end());
+        std::vector<int> single = INIT(1, 2).parallel(1);
+        ASSERT_EQ(single.size(), 2);
+
+        #if LANG_HAS_MANDATORY_COPY_ELISION
+        // Non-movable elements are constructed in place.
+        fixed_buffer<std::atomic_int> atomics = INIT(1, 2, 3).parallel();
+        ASSERT_EQ(atomics[2].load(), 3);
+        #endif
+
+        // If an element throws, the constructed ones are destroyed, and the exception is propagated.
+        struct Counted
+        {
+            static std::atomic_int &count() {static std::atomic_int ret{0}; return ret;}
+            Counted(int x)
+            {
+                if (x == 42)
+                    throw x;
+                count()++;
+            }
+            Counted(Counted &&) {count()++;}
+            ~Counted() {count()--;}
+        };
+        bool thrown = false;
+        try
+        {
+            std::vector<Counted> counted = INIT(1, spread(ints), 2).parallel(4);
+        }
+        catch (int x)
+        {
+            thrown = x == 42;
+        }
+        ASSERT(thrown);
+        ASSERT_EQ(Counted::count().load(), 0);
+
+        // Non-ranges can't be initialized.
+        static_assert(!std::is_constructible<std::array<int, 2>, decltype(INIT(1, 2).parallel())>::value, "");
+        static_assert(!std::is_constructible<std::vector<std::string>, decltype(INIT(1, 2).parallel())>::value, "");
+    }
+    #endif
+
+    #if BETTERLISTINIT_ARENA
+    { // Arenas.
+        using better_list_init::arena;
+        using better_list_init::spread;
+
+        // A counting upstream resource, to check that the buffer is allocated once.
+        struct CountingResource : std::pmr::memory_resource
+        {
+            int allocations = 0;
+            void *do_allocate(std::size_t bytes, std::size_t align) override {allocations++; return std::pmr::new_delete_resource()->allocate(bytes, align);}
+            void do_deallocate(void *p, std::size_t bytes, std::size_t align) override {std::pmr::new_delete_resource()->deallocate(p, bytes, align);}
+            bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {return this == &other;}
+        };
+        CountingResource counter;
+        std::pmr::memory_resource *old_default = std::pmr::set_default_resource(&counter);
+
+        std::vector<int> ints;
+        for (int i = 0; i < 500; i++)
+            ints.push_back(i);
+
+        {
+            arena<std::pmr::set<int>> set = INIT(-1, spread(ints)).in_arena();
+            ASSERT_EQ(set->size(), 501);
+            ASSERT_EQ(*set->begin(), -1);
+            ASSERT_EQ(counter.allocations, 1);
+
+            // Moving keeps the elements in the same arena.
+            const int *first = &*set->begin();
+            arena<std::pmr::set<int>> set2 = std::move(set);
+            ASSERT_EQ(&*set2->begin(), first);
+            ASSERT(set2->get_allocator().resource() == set2.resource());
+        }
+
+        // Nested payloads use the same resource.
+        counter.allocations = 0;
+        {
+            arena<std::pmr::map<int, std::pmr::string>> map = INIT(
+                std::make_pair(1, "a long string, to avoid the small string optimization"),
+                std::make_pair(2, "another long string, to avoid the small string optimization")
+            ).in_arena(256);
+            ASSERT_EQ(map->size(), 2);
+            ASSERT_EQ(map->at(2), "another long string, to avoid the small string optimization");
+            ASSERT(map->at(1).get_allocator().resource() == map.resource());
+            ASSERT_EQ(counter.allocations, 1);
+
+            // Empty lists.
+            arena<std::pmr::vector<int>> empty = INIT().in_arena();
+            ASSERT(empty->empty());
+        }
+
+        std::pmr::set_default_resource(old_default);
+
+        // Only containers with polymorphic allocators.
+        static_assert(!std::is_constructible<arena<std::vector<int>>, decltype(INIT(1, 2).in_arena())>::value, "");
+        static_assert(!std::is_constructible<arena<std::pmr::vector<std::string>>, decltype(INIT(1, 2).in_arena())>::value, "");
+    }
+    #endif
+
+    { // Constructing in uninitialized storage.
+        using better_list_init::when;
+
+        struct Storage
+        {
+            alignas(std::string) unsigned char bytes[sizeof(std::string) * 4];
+            std::string *get() {return reinterpret_cast<std::string *>(bytes);}
+        };
+        Storage storage;
+        std::string *strings = storage.get();
+
+        std::string str = "b";
+        std::size_t count = INIT("a", str, when(false, "x"), std::string("c")).construct_at(strings);
+        ASSERT_EQ(count, 3);
+        ASSERT_EQ(strings[0], "a");
+        ASSERT_EQ(strings[1], "b");
+        ASSERT_EQ(strings[2], "c");
+        ASSERT_EQ(str, "b");
+        for (std::size_t i = 0; i < count; i++)
+            strings[i].~basic_string();
+
+        // Non-movable elements, even without mandatory copy elision.
+        alignas(std::atomic_int) unsigned char atomic_bytes[sizeof(std::atomic_int) * 3];
+        std::atomic_int *atomics = reinterpret_cast<std::atomic_int *>(atomic_bytes);
+        const int x = 3;
+        ASSERT_EQ(INIT(1, 2L, x).construct_at(atomics), 3);
+        ASSERT_EQ(atomics[2].load(), 3);
+
+        // If a constructor throws, the constructed elements are destroyed.
+        struct Counted
+        {
+            int *alive;
+            Counted(int *alive) : alive(alive) {++*alive;}
+            Counted(std::nullptr_t) : alive(nullptr) {throw 42;}
+            ~Counted() {--*alive;}
+        };
+        alignas(Counted) unsigned char counted_bytes[sizeof(Counted) * 3];
+        int alive = 0;
+        try
+        {
+            (void)INIT(&alive, &alive, nullptr).construct_at(reinterpret_cast<Counted *>(counted_bytes));
+            ASSERT(false);
+        }
+        catch (int) {}
+        ASSERT_EQ(alive, 0);
+
+        // Not for spliced ranges, or const elements.
+        static_assert(!HasConstructAt<decltype(INIT(better_list_init::spread(std::vector<int>{}))), int>::value, "");
+        static_assert(!HasConstructAt<decltype(INIT(1, 2)), const int>::value, "");
+        static_assert(HasConstructAt<decltype(INIT(1, 2)), long>::value, "");
+    }
+
+    #if BETTERLISTINIT_VARIANT
+    { // Lists of alternatives to ranges of `std::variant`s.
+        using better_list_init::detail::variant_alternative;
+
+        // The matching alternatives are selected at compile-time, and constructed with `std::in_place_index`.
+        static_assert(variant_alternative<std::variant<int, long, std::string>, long &&>::index == 1, "");
+        static_assert(variant_alternative<std::variant<int, const std::string>, std::string &>::index == 1, "");
+        // Not for other types, or repeated alternatives. Those use the converting constructor.
+        static_assert(!variant_alternative<std::variant<int, long>, short>::value, "");
+        static_assert(!variant_alternative<std::variant<int, int>, int>::value, "");
+        static_assert(!variant_alternative<std::string, std::string>::value, "");
+
+        // Move-only alternatives.
+        std::string str = "foo";
+        std::vector<std::variant<int, std::string, std::unique_ptr<int>>> vec = INIT(1, std::make_unique<int>(2), str, "bar", std::string("baz"));
+        ASSERT_EQ(vec.size(), 5);
+        ASSERT_EQ(std::get<0>(vec[0]), 1);
+        ASSERT_EQ(*std::get<2>(vec[1]), 2);
+        ASSERT_EQ(std::get<1>(vec[2]), "foo");
+        ASSERT_EQ(std::get<1>(vec[3]), "bar");
+        ASSERT_EQ(std::get<1>(vec[4]), "baz");
+        ASSERT_EQ(str, "foo");
+
+        // Scalar alternatives.
+        std::vector<std::variant<long, float>> numbers = INIT(1L, 2.5f, 3L);
+        ASSERT_EQ(numbers[0].index(), 0);
+        ASSERT_EQ(numbers[1].index(), 1);
+
+        // Spliced ranges, and the non-movable alternatives.
+        std::vector<std::unique_ptr<int>> ptrs;
+        ptrs.push_back(std::make_unique<int>(3));
+        std::vector<std::variant<std::unique_ptr<int>, std::string>> vec2 = INIT(std::string("a"), better_list_init::spread(std::move(ptrs)));
+        ASSERT_EQ(*std::get<0>(vec2[1]), 3);
+        std::vector<std::variant<std::atomic_int, std::string>> vec3 = INIT(std::string("a"), 42);
+        ASSERT_EQ(std::get<0>(vec3[1]).load(), 42);
+    }
+    #endif
+
+    #if BETTERLISTINIT_BOXED
+    { // Boxing polymorphic objects.
+        using better_list_init::poly_buffer;
+
+        {
+            NamedRect rect("a long string, to avoid the small string optimization", 2, 3);
+            poly_buffer<Shape> shapes = INIT(Square(2), rect, NamedRect("b", 4, 5)).boxed<Shape>();
+            ASSERT_EQ(shapes.size(), 3);
+            ASSERT_EQ(Shape::alive, 4);
+            ASSERT_EQ(rect.name, "a long string, to avoid the small string optimization");
+
+            int total = 0;
+            for (Shape *shape : shapes)
+                total += shape->area();
+            ASSERT_EQ(total, 4 + 6 + 20);
+            ASSERT_EQ(static_cast<NamedRect *>(shapes[1])->name, rect.name);
+
+            // The objects are in the same block, in order, and correctly aligned.
+            ASSERT(reinterpret_cast<const char *>(shapes[0]) < reinterpret_cast<const char *>(shapes[1]));
+            ASSERT(reinterpret_cast<const char *>(shapes[2]) - reinterpret_cast<const char *>(shapes[0]) < 256);
+            ASSERT_EQ(reinterpret_cast<std::uintptr_t>(shapes[1]) % 32, 0);
+            ASSERT_EQ(reinterpret_cast<std::uintptr_t>(shapes[2]) % 32, 0);
+
+            poly_buffer<Shape> shapes2 = std::move(shapes);
+            ASSERT(shapes.empty() && shapes.begin() == shapes.end());
+            ASSERT_EQ(shapes2[0]->area(), 4);
+            shapes = std::move(shapes2);
+            ASSERT_EQ(shapes.size(), 3);
+            ASSERT_EQ(Shape::alive, 4);
+        }
+        ASSERT_EQ(Shape::alive, 0);
+
+        // If a constructor throws, the constructed objects are destroyed.
+        try
+        {
+            ThrowingShape throwing;
+            poly_buffer<Shape> shapes = INIT(Square(1), Square(2), throwing).boxed<Shape>();
+            ASSERT(false);
+        }
+        catch (int) {}
+        ASSERT_EQ(Shape::alive, 0);
+
+        poly_buffer<Shape> empty = INIT().boxed<Shape>();
+        ASSERT(empty.empty());
+
+        // Only for objects derived from `Base`, and not with optional elements.
+        static_assert(HasBoxed<decltype(INIT(Square(1))), Shape>::value, "");
+        static_assert(!HasBoxed<decltype(INIT(Square(1), 2)), Shape>::value, "");
+        static_assert(!HasBoxed<decltype(INIT(better_list_init::when(true, Square(1)))), Shape>::value, "");
+    }
+    #endif
+
+    #if BETTERLISTINIT_SHARED_ARRAY && BETTERLISTINIT_BOXED // For the `Shape` classes.
+    { // Shared arrays.
+        std::string str = "b";
+        std::shared_ptr<const std::string[]> strings = INIT("a", str, std::string("c"));
+        ASSERT_EQ(strings[0], "a");
+        ASSERT_EQ(strings[1], "b");
+        ASSERT_EQ(strings[2], "c");
+        ASSERT_EQ(str, "b");
+        std::shared_ptr<const std::string[]> copy = strings;
+        ASSERT_EQ(strings.use_count(), 2);
+
+        // Non-movable elements.
+        std::shared_ptr<std::atomic_int[]> atomics = INIT(1, 2, 3);
+        ASSERT_EQ(atomics[2].load(), 3);
+        #if CONTAINERS_HAVE_MANDATORY_COPY_ELISION
+        std::shared_ptr<std::atomic_int[]> atomics2 = INIT(1, 2L, better_list_init::repeat(2, 3));
+        ASSERT_EQ(atomics2[3].load(), 3);
+        #endif
+
+        // A single allocation, with a custom allocator.
+        int allocations = 0, live = 0;
+        {
+            std::shared_ptr<int[]> ints = INIT(1, 2, 3).and_with(CountingAllocator<int>(&allocations, &live));
+            ASSERT_EQ(ints[1], 2);
+            ASSERT_EQ(allocations, 1);
+            ASSERT_EQ(live, 1);
+
+            // The elements are aligned.
+            std::shared_ptr<NamedRect[]> rects = INIT(NamedRect("a", 1, 2), NamedRect("b", 3, 4)).and_with(CountingAllocator<int>(&allocations, &live));
+            ASSERT_EQ(reinterpret_cast<std::uintptr_t>(&rects[0]) % alignof(NamedRect), 0);
+            ASSERT_EQ(rects[1].name, "b");
+            ASSERT_EQ(allocations, 2);
+        }
+        ASSERT_EQ(live, 0);
+        ASSERT_EQ(Shape::alive, 0);
+
+        // If a constructor throws, the constructed elements are destroyed, and the memory is freed.
+        try
+        {
+            std::shared_ptr<ThrowingShape[]> shapes = INIT(ThrowingShape{}).and_with(CountingAllocator<int>(&allocations, &live));
+            ASSERT(false);
+        }
+        catch (int) {}
+        ASSERT_EQ(live, 0);
+        ASSERT_EQ(Shape::alive, 0);
+    }
+    #endif
+
+    #if BETTERLISTINIT_COROUTINES
+    { // Awaiting lists.
+        // Inline, with the results converted to a container.
+        ASSERT(SyncWait([]() -> Task<std::vector<std::string>>
+        {
+            Task<std::string> lvalue = Identity<std::string>("b");
+            co_return co_await INIT(Identity<std::string>("a"), lvalue, Identity<std::string>("c"));
+        }()) == (std::vector<std::string>{"a", "b", "c"}));
+
+        // Heterogeneous results to a tuple.
+        ASSERT(SyncWait([]() -> Task<std::tuple<int, std::string>>
+        {
+            co_return co_await INIT(Identity(1), Identity<std::string>("x"));
+        }()) == std::make_tuple(1, std::string("x")));
+
+        // The elements run concurrently on the thread pool.
+        ThreadPool pool(4);
+        ASSERT_EQ(pool.size(), 4);
+        std::vector<std::thread::id> ids = SyncWait([&]() -> Task<std::vector<std::thread::id>>
+        {
+            std::latch latch(4);
+            co_return co_await INIT(Rendezvous(latch), Rendezvous(latch), Rendezvous(latch), Rendezvous(latch)).when_all(pool);
+        }());
+        ASSERT_EQ(std::set<std::thread::id>(ids.begin(), ids.end()).size(), 4);
+
+        // An empty list.
+        ASSERT_EQ(SyncWait([&]() -> Task<std::size_t>
+        {
+            std::vector<int> empty = co_await INIT().when_all(pool);
+            co_return empty.size();
+        }()), 0);
+
+        // The exception is rethrown after all elements finish. The results of other elements are destroyed.
+        try
+        {
+            (void)SyncWait([&]() -> Task<int>
+            {
+                std::vector<std::string> unused = co_await INIT(Identity<std::string>(std::string(100, 'a')), Throwing(), Identity<std::string>("b")).when_all(pool);
+                co_return 0;
+            }());
+            ASSERT(false);
+        }
+        catch (int value)
+        {
+            ASSERT_EQ(value, 42);
+        }
+    }
+    #endif
+
+    #if BETTERLISTINIT_NUMERIC
+    { // Numeric types.
+        // `std::valarray` has no constructor from iterators.
+        std::valarray<double> arr = INIT(1, 2.5, better_list_init::when(false, 3), better_list_init::repeat(2, 4.f));
+        ASSERT_EQ(arr.size(), 4);
+        ASSERT_EQ(arr[1], 2.5);
+        ASSERT_EQ(arr.sum(), 11.5);
+        std::valarray<int> empty = INIT();
+        ASSERT_EQ(empty.size(), 0);
+
+        #if BETTERLISTINIT_HAVE_SIMD
+        namespace stdx = std::experimental;
+
+        // One element per lane.
+        stdx::fixed_size_simd<float, 4> vec = INIT(1, 2.f, 3.0, 4L);
+        ASSERT_EQ(vec[0], 1);
+        ASSERT_EQ(vec[3], 4);
+        ASSERT_EQ(stdx::reduce(vec), 10);
+
+        // A single value is still broadcasted, if the width is not 1.
+        stdx::fixed_size_simd<int, 3> same = INIT(5);
+        ASSERT_EQ(same[2], 5);
+
+        static_assert(!better_list_init::custom::is_range<stdx::native_simd<int>>::value, "");
+        static_assert(std::is_convertible<decltype(INIT(1, 2, 3, 4)), stdx::fixed_size_simd<int, 4>>::value, "");
+        static_assert(!std::is_constructible<stdx::fixed_size_simd<int, 4>, decltype(INIT(1, 2, 3))>::value, "");
+        static_assert(!std::is_constructible<stdx::fixed_size_simd<int, 2>, decltype(INIT(1, std::string{}))>::value, "");
+        #endif
+    }
+    #endif
+
+    #if BETTERLISTINIT_PADDED
+    { // Padded buffers.
+        using better_list_init::padded_buffer;
+        using better_list_init::repeat;
+
+        // Each element is in its own cache line. Even without mandatory copy elision, homogeneous lists of non-movable types are fine.
+        padded_buffer<std::atomic_int> counters = INIT(1, 2, 3);
+        ASSERT_EQ(counters.size(), 3);
+        ASSERT_EQ(counters[2].load(), 3);
+        for (std::size_t i = 0; i < counters.size(); i++)
+        {
+            ASSERT_EQ(reinterpret_cast<std::uintptr_t>(&counters[i]) % BETTERLISTINIT_CACHE_LINE_SIZE, 0);
+            if (i > 0)
+                ASSERT_EQ(reinterpret_cast<const char *>(&counters[i]) - reinterpret_cast<const char *>(&counters[i - 1]), BETTERLISTINIT_CACHE_LINE_SIZE);
+        }
+
+        #if CONTAINERS_HAVE_MANDATORY_COPY_ELISION
+        padded_buffer<std::atomic_int> counters2 = INIT(repeat(5, 0));
+        ASSERT_EQ(counters2.size(), 5);
+        ASSERT_EQ(counters2[4].load(), 0);
+        #endif
+
+        // The elements larger than `Align` are padded to a multiple of it. The iterators step over the padding.
+        static_assert(padded_buffer<char[20], 16>::stride == 32, "");
+        padded_buffer<std::string, 16> strings = INIT("a", std::string("b"), "c");
+        ASSERT_EQ(strings.size(), 3);
+        ASSERT_EQ(strings.end() - strings.begin(), 3);
+        ASSERT_EQ(strings.begin()[1], "b");
+        std::string joined;
+        for (const std::string &str : strings)
+            joined += str;
+        ASSERT_EQ(joined, "abc");
+        std::reverse(strings.begin(), strings.end());
+        ASSERT_EQ(strings[0], "c");
+        padded_buffer<std::string, 16>::const_iterator iter = strings.begin();
+        ASSERT(iter + 3 == strings.end() && *--(iter + 3) == "a");
+
+        // Moving.
+        padded_buffer<std::string, 16> strings2 = std::move(strings);
+        ASSERT(strings.empty());
+        ASSERT_EQ(strings2[2], "a");
+        strings = std::move(strings2);
+        ASSERT_EQ(strings.size(), 3);
+
+        padded_buffer<int> empty = INIT();
+        ASSERT(empty.empty() && empty.begin() == empty.end());
+    }
+    #endif
+
     std::cout << "OK";
     #if BETTERLISTINIT_CXX_STANDARD >= 17 && !CONTAINERS_HAVE_MANDATORY_COPY_ELISION
     std::cout << " (without mandatory copy elision)";